@@ -0,0 +1,147 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Ángulos binarios: una vuelta entera son 2^32 unidades de un uint32, así
+// que girar es sumar enteros y dar la vuelta sale gratis con el desborde.
+// Seno y coseno salen de una tabla de enteros calculada al compilar con
+// aritmética entera, interpolada también con enteros: el resultado es el
+// mismo bit a bit con cualquier compilador, nivel de optimización o
+// biblioteca matemática (std::sin/std::cos no lo garantizan).
+
+using BinaryAngle = std::uint32_t;
+
+constexpr BinaryAngle ANGLE_QUARTER_TURN = 0x40000000u;
+constexpr BinaryAngle ANGLE_HALF_TURN = 0x80000000u;
+
+// La tabla tiene 2^SINE_TABLE_BITS tramos por vuelta (más uno repetido al
+// final para interpolar sin comprobar el borde). Con 4096 tramos el error
+// de la interpolación lineal es menor que 4e-7 y la tabla ocupa 16 KB.
+constexpr int SINE_TABLE_BITS = 12;
+constexpr std::size_t SINE_TABLE_SIZE = std::size_t(1) << SINE_TABLE_BITS;
+
+// Los valores de la tabla son senos en punto fijo Q30 (1.0 = 2^30)
+constexpr std::int64_t SINE_ONE = std::int64_t(1) << 30;
+
+namespace angle_detail {
+
+// pi en Q30, redondeado
+constexpr std::int64_t PI_Q30 = 3373259426;
+
+// Seno de k/SINE_TABLE_SIZE de vuelta para k en el primer cuadrante, por
+// Taylor en Q30 (solo enteros: da lo mismo en cualquier compilador)
+constexpr std::int64_t quarterSine(std::int64_t k) {
+    const std::int64_t x = 2 * PI_Q30 * k / static_cast<std::int64_t>(SINE_TABLE_SIZE);
+    std::int64_t sum = x;
+    std::int64_t term = x;
+    for (std::int64_t n = 1; term != 0; ++n) {
+        term = term * x / SINE_ONE;
+        term = -(term * x / SINE_ONE) / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum < SINE_ONE ? sum : SINE_ONE;
+}
+
+constexpr std::array<std::int32_t, SINE_TABLE_SIZE + 1> makeSineTable() {
+    std::array<std::int32_t, SINE_TABLE_SIZE + 1> table{};
+    const std::int64_t quarter = static_cast<std::int64_t>(SINE_TABLE_SIZE / 4);
+    for (std::size_t i = 0; i <= SINE_TABLE_SIZE; ++i) {
+        const std::int64_t k = static_cast<std::int64_t>(i % SINE_TABLE_SIZE);
+        const std::int64_t r = k % quarter;
+        std::int64_t value = 0;
+        switch (k / quarter) {
+            case 0: value = quarterSine(r); break;
+            case 1: value = quarterSine(quarter - r); break;
+            case 2: value = -quarterSine(r); break;
+            default: value = -quarterSine(quarter - r); break;
+        }
+        table[i] = static_cast<std::int32_t>(value);
+    }
+    return table;
+}
+
+}  // namespace angle_detail
+
+inline constexpr std::array<std::int32_t, SINE_TABLE_SIZE + 1> SINE_TABLE = angle_detail::makeSineTable();
+
+// Seno en Q30: tramo de la tabla con los bits altos del ángulo e
+// interpolación lineal con los 16 siguientes
+inline std::int32_t sineQ30(BinaryAngle angle) {
+    const std::uint32_t index = angle >> (32 - SINE_TABLE_BITS);
+    const std::int64_t fraction = (angle >> (16 - SINE_TABLE_BITS)) & 0xFFFF;
+    const std::int64_t s0 = SINE_TABLE[index];
+    const std::int64_t s1 = SINE_TABLE[index + 1];
+    return static_cast<std::int32_t>(s0 + (s1 - s0) * fraction / 65536);
+}
+
+// Q30 a float: la conversión de entero redondea igual en todas partes y
+// multiplicar por una potencia de dos es exacto
+inline float fromQ30(std::int32_t value) {
+    return static_cast<float>(value) * (1.0f / 1073741824.0f);
+}
+
+inline float sine(BinaryAngle angle) {
+    return fromQ30(sineQ30(angle));
+}
+
+inline float cosine(BinaryAngle angle) {
+    return fromQ30(sineQ30(angle + ANGLE_QUARTER_TURN));
+}
+
+// Vector unitario (coseno, seno) del ángulo
+inline sf::Vector2f angleDirection(BinaryAngle angle) {
+    return { cosine(angle), sine(angle) };
+}
+
+// Coseno y seno de n ángulos de una vez (arrays SoA). Sin ramas ni
+// llamadas: un bucle de cargas de tabla y aritmética entera.
+inline void sinCos(const BinaryAngle* angles, float* cosines, float* sines, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        cosines[i] = cosine(angles[i]);
+        sines[i] = sine(angles[i]);
+    }
+}
+
+// Conversiones. De grados y radianes se pasa por double y se trunca a
+// entero de 64 bits, así que el ángulo binario sale igual en cualquier
+// máquina; los negativos y los de más de una vuelta se envuelven solos.
+constexpr BinaryAngle angleFromDegrees(float degrees) {
+    return static_cast<BinaryAngle>(static_cast<std::int64_t>(static_cast<double>(degrees) * (4294967296.0 / 360.0)));
+}
+
+constexpr BinaryAngle angleFromRadians(double radians) {
+    return static_cast<BinaryAngle>(static_cast<std::int64_t>(radians * (2147483648.0 / 3.14159265358979323846)));
+}
+
+// Entre 0 y 360
+constexpr float angleToDegrees(BinaryAngle angle) {
+    return static_cast<float>(static_cast<double>(angle) * (360.0 / 4294967296.0));
+}
+
+// Entre 0 y 2*pi
+constexpr double angleToRadians(BinaryAngle angle) {
+    return static_cast<double>(angle) * (3.14159265358979323846 / 2147483648.0);
+}
+
+// Giro más corto de 'from' a 'to', con signo (media vuelta como mucho)
+constexpr std::int32_t angleDelta(BinaryAngle from, BinaryAngle to) {
+    return static_cast<std::int32_t>(to - from);
+}
+
+// Giro con signo en radianes
+inline float turnToRadians(std::int32_t turn) {
+    return static_cast<float>(turn) * (3.14159265f / 2147483648.0f);
+}
+
+// Fracción t (0..1) de un giro con signo
+inline BinaryAngle scaleTurn(std::int32_t turn, float t) {
+    return static_cast<BinaryAngle>(static_cast<std::int32_t>(static_cast<double>(turn) * t));
+}
+
+// Interpolación por el camino más corto
+inline BinaryAngle lerpAngle(BinaryAngle from, BinaryAngle to, float t) {
+    return from + scaleTurn(angleDelta(from, to), t);
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "GameConfig.hpp"
+#include "EntityArrays.hpp"
+#include "EntityPool.hpp"
+#include "Simulation.hpp"
+#include "SpatialGrid.hpp"
+
+// Mundo de varias naves para el servidor multijugador. Usa las mismas piezas
+// que Simulation (advancePlayer, los kernels de integración, TickSweep y la
+// rejilla), pero la partida no termina: una nave que choca reaparece al rato
+// en otro sitio y los asteroides destruidos se reponen. Corre en un solo hilo.
+
+constexpr int ARENA_MAX_SHIPS = 8;
+constexpr float ARENA_RESPAWN_TIME = 2.0f;
+// Tiempo tras reaparecer en que los asteroides no matan a la nave: con muchos
+// asteroides puede no haber sitio libre y moriría nada más aparecer
+constexpr float ARENA_RESPAWN_GRACE = 2.0f;
+// Distancia mínima a un asteroide para reaparecer, y a una nave para reponer
+// un asteroide
+constexpr float ARENA_SAFE_DISTANCE = 150.0f;
+
+// Balas con la nave que las disparó (para el puntaje)
+struct OwnedBulletArrays : BulletArrays {
+    std::vector<std::uint8_t> owner;
+
+    void reserve(size_t n) {
+        BulletArrays::reserve(n);
+        owner.reserve(n);
+    }
+
+    void push(const sf::Vector2f& position, const sf::Vector2f& direction, float lifetime, std::uint8_t shooter) {
+        BulletArrays::push(position, direction, lifetime);
+        owner.push_back(shooter);
+    }
+
+    void swapRemove(size_t i) {
+        owner[i] = owner.back();
+        owner.pop_back();
+        BulletArrays::swapRemove(i);
+    }
+
+    void clear() {
+        BulletArrays::clear();
+        owner.clear();
+    }
+};
+
+struct ArenaShip {
+    PlayerState state;
+    bool joined = false;   // Hay un jugador en este hueco
+    bool alive = false;
+    float respawnTimer = 0.0f;
+    float graceTimer = 0.0f;  // Invulnerable mientras sea positivo
+    int score = 0;
+};
+
+struct ArenaConfig {
+    std::uint32_t asteroids = 20;  // Asteroides que hay siempre
+    std::uint32_t maxBullets = 1024;
+    std::uint32_t maxAsteroids = 4096;
+};
+
+class ArenaSimulation {
+public:
+    explicit ArenaSimulation(std::uint32_t seed, const ArenaConfig& config = ArenaConfig())
+        : bullets(config.maxBullets),
+          asteroids(config.maxAsteroids),
+          config(config),
+          rng(seed),
+          grid(ASTEROID_W, SCREEN_WIDTH, SCREEN_HEIGHT) {
+        grid.reserve(config.maxAsteroids);
+        expired.reserve(config.maxBullets);
+        bulletKills.reserve(config.maxBullets);
+        asteroidKills.reserve(config.maxBullets);
+        spawns.reserve(ARENA_MAX_SHIPS);
+        spawnOwners.reserve(ARENA_MAX_SHIPS);
+        impacts.reserve(256);
+        replenishAsteroids();
+    }
+
+    // Ocupa un hueco libre para un jugador nuevo; -1 si no hay
+    int join() {
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            if (!ships[i].joined) {
+                ships[i] = ArenaShip();
+                ships[i].joined = true;
+                respawn(ships[i]);
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void leave(int ship) {
+        ships[ship] = ArenaShip();
+    }
+
+    int shipCount() const {
+        int count = 0;
+        for (const ArenaShip& ship : ships) {
+            count += ship.joined ? 1 : 0;
+        }
+        return count;
+    }
+
+    // Avanza un tick; inputs[i] es la entrada de la nave i (ARENA_MAX_SHIPS valores)
+    void step(const std::uint8_t* inputs, float dt) {
+        events = TickEvents();
+        ++tick;
+
+        integrateBullets(bullets.arrays, BULLET_SPEED, dt);
+        collectExpiredBullets(bullets.arrays, expired);
+        for (std::uint32_t b : expired) {
+            bulletKills.push_back(bullets.handleAt(b));
+        }
+        expired.clear();
+        integrateAsteroids(asteroids.arrays, ASTEROID_SPEED, ASTEROID_SPIN, ASTEROID_BOUNDS, dt);
+
+        std::array<PlayerState, ARENA_MAX_SHIPS> previous;
+        std::array<bool, ARENA_MAX_SHIPS> moved{};
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            ArenaShip& ship = ships[i];
+            if (!ship.joined) {
+                continue;
+            }
+            if (!ship.alive) {
+                ship.respawnTimer -= dt;
+                if (ship.respawnTimer <= 0.0f) {
+                    respawn(ship);
+                }
+                continue;
+            }
+            ship.graceTimer = std::max(0.0f, ship.graceTimer - dt);
+            previous[i] = ship.state;
+            moved[i] = true;
+            advancePlayer(ship.state, inputs[i], dt, spawns, events);
+            // Las balas nuevas de esta nave son las que aún no tienen dueño
+            spawnOwners.resize(spawns.size(), static_cast<std::uint8_t>(i));
+        }
+
+        detectCollisions(previous, moved, dt);
+
+        for (auto& handle : bulletKills) {
+            bullets.kill(handle);
+        }
+        for (auto& handle : asteroidKills) {
+            if (asteroids.kill(handle)) {
+                ++events.kills;
+            }
+        }
+        bulletKills.clear();
+        asteroidKills.clear();
+        for (size_t s = 0; s < spawns.size(); s++) {
+            bullets.spawn(spawns[s].position, spawns[s].direction, BULLET_LIFE, spawnOwners[s]);
+        }
+        spawns.clear();
+        spawnOwners.clear();
+        replenishAsteroids();
+    }
+
+    std::array<ArenaShip, ARENA_MAX_SHIPS> ships;
+    EntityPool<OwnedBulletArrays> bullets;
+    EntityPool<AsteroidArrays> asteroids;
+    std::uint64_t tick = 0;
+    TickEvents events;
+
+private:
+    void detectCollisions(const std::array<PlayerState, ARENA_MAX_SHIPS>& previous,
+                          const std::array<bool, ARENA_MAX_SHIPS>& moved, float dt) {
+        grid.clear();
+        for (size_t i = 0; i < asteroids.size(); i++) {
+            grid.insert(static_cast<std::uint32_t>(i), asteroids.arrays.position(i));
+        }
+        grid.build();
+        const TickSweep sweep(dt);
+
+        // Balas contra asteroides: como en Simulation, gana el primer contacto
+        // en el tiempo y cada asteroide para una sola bala
+        for (size_t b = 0; b < bullets.size(); b++) {
+            grid.query(sweep.bulletCenter(bullets.arrays, b), sweep.bulletReach(), [&](std::uint32_t a) {
+                float time = sweep.bulletAsteroid(bullets.arrays, b, asteroids.arrays, a);
+                if (time >= 0.0f) {
+                    impacts.push_back({ time, static_cast<std::uint32_t>(b), a });
+                }
+            });
+        }
+        if (!impacts.empty()) {
+            std::sort(impacts.begin(), impacts.end(), [](const Impact& a, const Impact& b) {
+                if (a.time != b.time) return a.time < b.time;
+                if (a.bullet != b.bullet) return a.bullet < b.bullet;
+                return a.asteroid < b.asteroid;
+            });
+            bulletHit.assign(bullets.size(), 0);
+            asteroidHit.assign(asteroids.size(), 0);
+            for (const Impact& impact : impacts) {
+                if (bulletHit[impact.bullet] || asteroidHit[impact.asteroid]) {
+                    continue;
+                }
+                bulletHit[impact.bullet] = 1;
+                asteroidHit[impact.asteroid] = 1;
+                bulletKills.push_back(bullets.handleAt(impact.bullet));
+                asteroidKills.push_back(asteroids.handleAt(impact.asteroid));
+                ArenaShip& shooter = ships[bullets.arrays.owner[impact.bullet]];
+                if (shooter.joined) {
+                    shooter.score += 20;
+                }
+            }
+            impacts.clear();
+        }
+
+        // Naves contra asteroides: la que choca reaparece más tarde
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            if (!moved[i] || ships[i].graceTimer > 0.0f) {
+                continue;
+            }
+            ArenaShip& ship = ships[i];
+            bool hit = false;
+            grid.query(sweep.shipCenter(previous[i], ship.state), sweep.shipReach(previous[i], ship.state),
+                       [&](std::uint32_t a) {
+                if (!hit && sweep.shipAsteroid(previous[i], ship.state, asteroids.arrays, a) >= 0.0f) {
+                    hit = true;
+                }
+            });
+            if (hit) {
+                ship.alive = false;
+                ship.respawnTimer = ARENA_RESPAWN_TIME;
+            }
+        }
+    }
+
+    // Reaparece en un punto sin asteroides cerca (si lo encuentra en pocos intentos)
+    void respawn(ArenaShip& ship) {
+        sf::Vector2f position;
+        for (int attempt = 0; attempt < 16; attempt++) {
+            float x = randomRange(rng, PLAYER_W, SCREEN_WIDTH - PLAYER_W);
+            position = { x, randomRange(rng, PLAYER_H, SCREEN_HEIGHT - PLAYER_H) };
+            if (clearOfAsteroids(position)) {
+                break;
+            }
+        }
+        ship.state = PlayerState();
+        ship.state.position = position;
+        ship.alive = true;
+        ship.respawnTimer = 0.0f;
+        ship.graceTimer = ARENA_RESPAWN_GRACE;
+    }
+
+    bool clearOfAsteroids(const sf::Vector2f& position) const {
+        const AsteroidArrays& a = asteroids.arrays;
+        for (size_t i = 0; i < a.size(); i++) {
+            float dx = a.x[i] - position.x;
+            float dy = a.y[i] - position.y;
+            if (dx * dx + dy * dy < ARENA_SAFE_DISTANCE * ARENA_SAFE_DISTANCE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool clearOfShips(const sf::Vector2f& position) const {
+        for (const ArenaShip& ship : ships) {
+            if (!ship.alive) {
+                continue;
+            }
+            sf::Vector2f d = ship.state.position - position;
+            if (d.x * d.x + d.y * d.y < ARENA_SAFE_DISTANCE * ARENA_SAFE_DISTANCE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Los asteroides destruidos se reponen lejos de las naves
+    void replenishAsteroids() {
+        std::uint32_t target = std::min(config.asteroids, asteroids.capacity());
+        while (asteroids.size() < target) {
+            sf::Vector2f position = randomAsteroidPosition(rng);
+            for (int attempt = 0; attempt < 8 && !clearOfShips(position); attempt++) {
+                position = randomAsteroidPosition(rng);
+            }
+            asteroids.spawn(position, randomAsteroidDirection(rng));
+        }
+    }
+
+    ArenaConfig config;
+    std::mt19937 rng;
+    SpatialGrid grid;
+    std::vector<std::uint32_t> expired;
+    std::vector<EntityHandle> bulletKills;
+    std::vector<EntityHandle> asteroidKills;
+    std::vector<BulletSpawn> spawns;
+    std::vector<std::uint8_t> spawnOwners;
+    std::vector<Impact> impacts;
+    std::vector<std::uint8_t> bulletHit;
+    std::vector<std::uint8_t> asteroidHit;
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Formato del archivo de recursos empaquetado (assets.pak):
+//
+//   PakHeader | PakEntry[entryCount] | datos (cada bloque alineado a 16 bytes)
+//
+// Los nombres son las rutas que usa el juego ("assets/fonts/Minecraft.ttf").
+// Los efectos de sonido cortos se guardan ya decodificados como PCM de 16 bits
+// para no tener que decodificar MP3/WAV al arrancar. Todo en little-endian.
+
+constexpr char PAK_MAGIC[4] = { 'S', 'H', 'P', 'K' };
+constexpr std::uint32_t PAK_VERSION = 1;
+constexpr std::size_t PAK_NAME_SIZE = 64;
+constexpr std::size_t PAK_ALIGNMENT = 16;
+
+enum class PakEntryType : std::uint32_t {
+    Raw = 0,  // bytes del archivo original
+    Pcm = 1   // muestras Int16 intercaladas, con sampleRate y channelCount
+};
+
+struct PakHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+};
+
+struct PakEntry {
+    char name[PAK_NAME_SIZE];
+    PakEntryType type;
+    std::uint32_t sampleRate;
+    std::uint32_t channelCount;
+    std::uint32_t reserved;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+static_assert(sizeof(PakHeader) == 16, "PakHeader debe ocupar 16 bytes");
+static_assert(sizeof(PakEntry) == 96, "PakEntry debe ocupar 96 bytes");
+
+// Archivo proyectado en memoria de solo lectura
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        bytes = static_cast<const char*>(address);
+        length = static_cast<std::size_t>(info.st_size);
+#endif
+        if (!bytes) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (bytes) {
+            UnmapViewOfFile(bytes);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) {
+            munmap(const_cast<char*>(bytes), length);
+        }
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+// Lectura del archivo empaquetado. Los datos se devuelven como punteros
+// dentro de la proyección: no se copia nada, así que el archivo debe seguir
+// abierto mientras se usen.
+class AssetArchive {
+public:
+    bool open(const std::string& path) {
+        if (!file.open(path)) {
+            return false;
+        }
+        if (file.size() < sizeof(PakHeader)) {
+            file.close();
+            return false;
+        }
+        const PakHeader* header = reinterpret_cast<const PakHeader*>(file.data());
+        std::size_t indexEnd = sizeof(PakHeader) + static_cast<std::size_t>(header->entryCount) * sizeof(PakEntry);
+        if (std::memcmp(header->magic, PAK_MAGIC, sizeof(PAK_MAGIC)) != 0 || header->version != PAK_VERSION
+            || indexEnd > file.size()) {
+            file.close();
+            return false;
+        }
+        entries = reinterpret_cast<const PakEntry*>(file.data() + sizeof(PakHeader));
+        count = header->entryCount;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            // Sin sumar: offset + size podría desbordar en un pak corrupto
+            if (entries[i].offset > file.size() || entries[i].size > file.size() - entries[i].offset) {
+                file.close();
+                entries = nullptr;
+                count = 0;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isOpen() const { return file.data() != nullptr; }
+
+    // Busca una entrada por nombre (búsqueda lineal: hay pocas entradas)
+    const PakEntry* find(const std::string& name) const {
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (std::strncmp(entries[i].name, name.c_str(), PAK_NAME_SIZE) == 0) {
+                return &entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const char* data(const PakEntry& entry) const {
+        return file.data() + entry.offset;
+    }
+
+private:
+    MappedFile file;
+    const PakEntry* entries = nullptr;
+    std::uint32_t count = 0;
+};
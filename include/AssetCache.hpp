@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AssetArchive.hpp"
+
+// Recurso compartido e inmutable (nulo si la carga falló)
+template <typename T>
+using AssetHandle = std::shared_ptr<const T>;
+
+// Contenido en bruto de un archivo (por ejemplo, música que se reproduce
+// en streaming desde memoria con openFromMemory). Puede tener sus propios
+// bytes o ser una vista dentro de un AssetArchive proyectado en memoria.
+class FileData {
+public:
+    explicit FileData(std::vector<char> bytes)
+        : owned(std::move(bytes)), view(owned.data()), length(owned.size()) {}
+
+    FileData(const char* view, std::size_t size, std::shared_ptr<const AssetArchive> archive)
+        : view(view), length(size), archive(std::move(archive)) {}
+
+    // 'view' puede apuntar a 'owned': copiarlo dejaría la vista colgando
+    FileData(const FileData&) = delete;
+    FileData& operator=(const FileData&) = delete;
+
+    const char* data() const { return view; }
+    std::size_t size() const { return length; }
+
+private:
+    std::vector<char> owned;
+    const char* view;
+    std::size_t length;
+    std::shared_ptr<const AssetArchive> archive;  // mantiene viva la proyección
+};
+
+// Caché central de recursos. Cada ruta se carga una sola vez, en un hilo
+// aparte; las peticiones repetidas devuelven el mismo handle. 'preload'
+// vuelve enseguida, así que la ventana puede seguir pintando mientras tanto.
+// Si hay un archivo empaquetado montado, los recursos salen de él (sin abrir
+// archivos sueltos); si no, de disco.
+class AssetCache {
+public:
+    // Debe llamarse antes de pedir ningún recurso
+    void mount(std::shared_ptr<const AssetArchive> packed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        archive = std::move(packed);
+    }
+
+    void preloadFont(const std::string& path) { requestFont(path); }
+    void preloadSound(const std::string& path) { requestSound(path); }
+    void preloadFile(const std::string& path) { requestFile(path); }
+
+    // Devuelven el recurso, esperando a que termine de cargarse si hace falta
+    AssetHandle<sf::Font> font(const std::string& path) { return requestFont(path).get(); }
+    AssetHandle<sf::SoundBuffer> sound(const std::string& path) { return requestSound(path).get(); }
+    AssetHandle<FileData> file(const std::string& path) { return requestFile(path).get(); }
+
+    // true si todo lo pedido hasta ahora ya terminó de cargarse (sin bloquear)
+    bool allReady() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return isReady(fonts) && isReady(sounds) && isReady(files);
+    }
+
+private:
+    template <typename T>
+    using Pending = std::map<std::string, std::shared_future<AssetHandle<T>>>;
+
+    std::shared_future<AssetHandle<sf::Font>> requestFont(const std::string& path) {
+        return request(fonts, path, &loadFont);
+    }
+    std::shared_future<AssetHandle<sf::SoundBuffer>> requestSound(const std::string& path) {
+        return request(sounds, path, &loadSound);
+    }
+    std::shared_future<AssetHandle<FileData>> requestFile(const std::string& path) {
+        return request(files, path, &loadFile);
+    }
+
+    template <typename T>
+    using Loader = AssetHandle<T> (*)(const std::string&, std::shared_ptr<const AssetArchive>);
+
+    template <typename T>
+    std::shared_future<AssetHandle<T>> request(Pending<T>& pending, const std::string& path, Loader<T> loader) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pending.find(path);
+        if (it != pending.end()) {
+            return it->second;
+        }
+        auto future = std::async(std::launch::async, loader, path, archive).share();
+        pending.emplace(path, future);
+        return future;
+    }
+
+    template <typename T>
+    static bool isReady(const Pending<T>& pending) {
+        for (const auto& entry : pending) {
+            if (entry.second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static AssetHandle<sf::Font> loadFont(const std::string& path, std::shared_ptr<const AssetArchive> archive) {
+        // La fuente lee los glifos directamente de los bytes que se le pasan,
+        // así que se guarda junto a ellos (la proyección o la copia)
+        struct FontWithData {
+            AssetHandle<FileData> data;
+            sf::Font font;
+        };
+        AssetHandle<FileData> data = loadFile(path, archive);
+        if (!data) {
+            return nullptr;
+        }
+        auto owner = std::make_shared<FontWithData>();
+        owner->data = data;
+        if (!owner->font.loadFromMemory(data->data(), data->size())) {
+            std::cerr << "Error al cargar la fuente " << path << std::endl;
+            return nullptr;
+        }
+        return AssetHandle<sf::Font>(owner, &owner->font);
+    }
+
+    static AssetHandle<sf::SoundBuffer> loadSound(const std::string& path, std::shared_ptr<const AssetArchive> archive) {
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        const PakEntry* entry = archive ? archive->find(path) : nullptr;
+        bool loaded;
+        if (entry && entry->type == PakEntryType::Pcm) {
+            // Ya decodificado al empaquetar: solo hay que subirlo al buffer de audio
+            const sf::Int16* samples = reinterpret_cast<const sf::Int16*>(archive->data(*entry));
+            loaded = buffer->loadFromSamples(samples, entry->size / sizeof(sf::Int16),
+                                             entry->channelCount, entry->sampleRate);
+        } else if (entry) {
+            loaded = buffer->loadFromMemory(archive->data(*entry), static_cast<std::size_t>(entry->size));
+        } else {
+            loaded = buffer->loadFromFile(path);
+        }
+        if (!loaded) {
+            std::cerr << "Error al cargar el sonido " << path << std::endl;
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    static AssetHandle<FileData> loadFile(const std::string& path, std::shared_ptr<const AssetArchive> archive) {
+        if (archive) {
+            const PakEntry* entry = archive->find(path);
+            if (entry && entry->type == PakEntryType::Raw) {
+                return std::make_shared<FileData>(archive->data(*entry), static_cast<std::size_t>(entry->size), archive);
+            }
+        }
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Error al abrir el archivo " << path << std::endl;
+            return nullptr;
+        }
+        return std::make_shared<FileData>(std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+    }
+
+    std::shared_ptr<const AssetArchive> archive;
+    std::mutex mutex;
+    Pending<sf::Font> fonts;
+    Pending<sf::SoundBuffer> sounds;
+    Pending<FileData> files;
+};
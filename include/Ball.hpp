@@ -1,34 +1,74 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
 #include <chipmunk/chipmunk.h>
 
 class Ball {
 public:
-    Ball(cpSpace* space, float radius, float mass, const cpVect& position) {
+    Ball(cpSpace* space, float radius, float mass, const cpVect& position)
+        : space(space), radius(radius), ballShape(radius) {
         cpFloat moment = cpMomentForCircle(mass, 0, radius, cpvzero);
         body = cpSpaceAddBody(space, cpBodyNew(mass, moment));
         cpBodySetPosition(body, position);
         shape = cpSpaceAddShape(space, cpCircleShapeNew(body, radius, cpvzero));
         cpShapeSetFriction(shape, 0.7);
+
+        // La figura se crea una vez; GetShape solo la recoloca
+        ballShape.setOrigin(radius, radius);
+        ballShape.setFillColor(sf::Color::Red);
     }
 
-    sf::CircleShape GetShape() {
-        sf::CircleShape ballShape(20.0);
+    Ball(const Ball&) = delete;
+    Ball& operator=(const Ball&) = delete;
+
+    const sf::CircleShape& GetShape() {
         cpVect ballPosition = cpBodyGetPosition(body);
-        ballShape.setPosition(ballPosition.x, ballPosition.y);
-        ballShape.setFillColor(sf::Color::Red);
+        ballShape.setPosition(static_cast<float>(ballPosition.x), static_cast<float>(ballPosition.y));
         return ballShape;
     }
 
     ~Ball() {
+        // Hay que sacarlos del espacio antes de liberarlos
+        removeFromSpace();
         cpShapeFree(shape);
         cpBodyFree(body);
     }
 
+    // Saca el cuerpo y la figura del espacio sin liberarlos, para volver a
+    // meterlos después con addToSpace (sin reservar memoria)
+    void removeFromSpace() {
+        if (inSpace) {
+            cpSpaceRemoveShape(space, shape);
+            cpSpaceRemoveBody(space, body);
+            inSpace = false;
+        }
+    }
+
+    void addToSpace() {
+        if (!inSpace) {
+            cpSpaceAddBody(space, body);
+            cpSpaceAddShape(space, shape);
+            inSpace = true;
+        }
+    }
+
     cpBody* getBody() {
         return body;
     }
 
+    cpShape* getPhysicsShape() {
+        return shape;
+    }
+
+    float getRadius() const {
+        return radius;
+    }
+
 private:
-    int radius;
+    cpSpace* space;
+    float radius;
     cpBody* body;
     cpShape* shape;
-};
\ No newline at end of file
+    bool inSpace = true;
+    sf::CircleShape ballShape;
+};
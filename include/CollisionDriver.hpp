@@ -0,0 +1,470 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AngleMath.hpp"
+
+// Función auxiliar para verificar colisión circular
+inline bool checkCollision(const sf::Vector2f& pos1, float radius1, const sf::Vector2f& pos2, float radius2) {
+    float dx = pos1.x - pos2.x;
+    float dy = pos1.y - pos2.y;
+    float distanceSquared = dx * dx + dy * dy;
+    float radiusSum = radius1 + radius2;
+    return distanceSquared <= (radiusSum * radiusSum);
+}
+
+// Narrowphase exacto con polígonos -----------------------------------------
+
+constexpr int HULL_MAX_VERTS = 8;
+constexpr int HULL_MAX_PIECES = 12;
+
+// Pieza convexa en espacio local. Los ejes son las normales de las aristas
+// sin normalizar (para SAT entre polígonos basta, y así no hace falta sqrt).
+struct ConvexPiece {
+    int count = 0;
+    sf::Vector2f verts[HULL_MAX_VERTS];
+    sf::Vector2f axes[HULL_MAX_VERTS];
+    sf::Vector2f center;
+    float radius = 0.0f;
+};
+
+// Posición y giro de un casco en el mundo (coseno y seno ya calculados)
+struct HullPose {
+    sf::Vector2f position;
+    float c = 1.0f;
+    float s = 0.0f;
+
+    static HullPose fromAngle(const sf::Vector2f& position, BinaryAngle angle) {
+        return { position, cosine(angle), sine(angle) };
+    }
+
+    sf::Vector2f apply(const sf::Vector2f& p) const {
+        return { position.x + p.x * c - p.y * s, position.y + p.x * s + p.y * c };
+    }
+
+    sf::Vector2f rotate(const sf::Vector2f& v) const {
+        return { v.x * c - v.y * s, v.x * s + v.y * c };
+    }
+
+    // De mundo a espacio local (giro inverso)
+    sf::Vector2f toLocal(const sf::Vector2f& p) const {
+        float dx = p.x - position.x;
+        float dy = p.y - position.y;
+        return { dx * c + dy * s, -dx * s + dy * c };
+    }
+};
+
+// Casco de colisión: descomposición convexa de un polígono simple (puede ser
+// cóncavo), calculada una sola vez. Las consultas trabajan en arrays de tamaño
+// fijo en la pila y empiezan con una prueba de círculos envolventes.
+class CollisionHull {
+public:
+    // 'points' es el contorno sin repetir el primer punto al final
+    CollisionHull(const sf::Vector2f* points, size_t count) {
+        std::vector<sf::Vector2f> poly(points, points + count);
+        if (signedArea(poly) < 0.0f) {
+            std::reverse(poly.begin(), poly.end());
+        }
+        std::vector<std::vector<int>> parts = mergeConvex(poly, triangulate(poly));
+        if (parts.size() > static_cast<size_t>(HULL_MAX_PIECES)) {
+            throw std::runtime_error("Casco con demasiadas piezas convexas");
+        }
+
+        for (const auto& part : parts) {
+            ConvexPiece& piece = pieces[pieceCount++];
+            piece.count = static_cast<int>(part.size());
+            sf::Vector2f sum;
+            for (int i = 0; i < piece.count; ++i) {
+                piece.verts[i] = poly[part[i]];
+                sum += piece.verts[i];
+            }
+            piece.center = sum / static_cast<float>(piece.count);
+            for (int i = 0; i < piece.count; ++i) {
+                sf::Vector2f edge = piece.verts[(i + 1) % piece.count] - piece.verts[i];
+                piece.axes[i] = { edge.y, -edge.x };  // normal exterior (polígono CCW)
+                sf::Vector2f d = piece.verts[i] - piece.center;
+                piece.radius = std::max(piece.radius, std::sqrt(d.x * d.x + d.y * d.y));
+            }
+        }
+        for (const auto& p : poly) {
+            boundingRadius = std::max(boundingRadius, std::sqrt(p.x * p.x + p.y * p.y));
+        }
+    }
+
+    int getPieceCount() const { return pieceCount; }
+    const ConvexPiece& getPiece(int i) const { return pieces[i]; }
+    float getBoundingRadius() const { return boundingRadius; }
+
+private:
+    static float cross(const sf::Vector2f& o, const sf::Vector2f& a, const sf::Vector2f& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    static float signedArea(const std::vector<sf::Vector2f>& poly) {
+        float area = 0.0f;
+        for (size_t i = 0; i < poly.size(); ++i) {
+            const sf::Vector2f& a = poly[i];
+            const sf::Vector2f& b = poly[(i + 1) % poly.size()];
+            area += a.x * b.y - b.x * a.y;
+        }
+        return area * 0.5f;
+    }
+
+    static bool pointInTriangle(const sf::Vector2f& p, const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+        return cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f;
+    }
+
+    // Triangulación por recorte de orejas (polígono CCW)
+    static std::vector<std::vector<int>> triangulate(const std::vector<sf::Vector2f>& poly) {
+        std::vector<std::vector<int>> triangles;
+        std::vector<int> remaining;
+        for (int i = 0; i < static_cast<int>(poly.size()); ++i) {
+            remaining.push_back(i);
+        }
+        while (remaining.size() > 3) {
+            bool clipped = false;
+            for (size_t i = 0; i < remaining.size(); ++i) {
+                int prev = remaining[(i + remaining.size() - 1) % remaining.size()];
+                int cur = remaining[i];
+                int next = remaining[(i + 1) % remaining.size()];
+                if (cross(poly[prev], poly[cur], poly[next]) <= 0.0f) {
+                    continue;  // vértice reflejo
+                }
+                bool ear = true;
+                for (int other : remaining) {
+                    if (other != prev && other != cur && other != next
+                        && pointInTriangle(poly[other], poly[prev], poly[cur], poly[next])) {
+                        ear = false;
+                        break;
+                    }
+                }
+                if (ear) {
+                    triangles.push_back({ prev, cur, next });
+                    remaining.erase(remaining.begin() + i);
+                    clipped = true;
+                    break;
+                }
+            }
+            if (!clipped) {
+                throw std::runtime_error("El casco no es un polígono simple");
+            }
+        }
+        triangles.push_back(remaining);
+        return triangles;
+    }
+
+    static bool isConvex(const std::vector<sf::Vector2f>& poly, const std::vector<int>& part) {
+        for (size_t i = 0; i < part.size(); ++i) {
+            const sf::Vector2f& a = poly[part[i]];
+            const sf::Vector2f& b = poly[part[(i + 1) % part.size()]];
+            const sf::Vector2f& c = poly[part[(i + 2) % part.size()]];
+            if (cross(a, b, c) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Une piezas vecinas mientras el resultado siga siendo convexo
+    // (Hertel-Mehlhorn), para que haya menos piezas que probar
+    static std::vector<std::vector<int>> mergeConvex(const std::vector<sf::Vector2f>& poly,
+                                                     std::vector<std::vector<int>> parts) {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < parts.size() && !merged; ++i) {
+                for (size_t j = i + 1; j < parts.size() && !merged; ++j) {
+                    std::vector<int> joined = joinAlongSharedEdge(parts[i], parts[j]);
+                    if (!joined.empty() && joined.size() <= static_cast<size_t>(HULL_MAX_VERTS)
+                        && isConvex(poly, joined)) {
+                        parts[i] = joined;
+                        parts.erase(parts.begin() + j);
+                        merged = true;
+                    }
+                }
+            }
+        }
+        return parts;
+    }
+
+    // Si a y b comparten una arista (a: u->v, b: v->u) devuelve su unión
+    static std::vector<int> joinAlongSharedEdge(const std::vector<int>& a, const std::vector<int>& b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            int u = a[i];
+            int v = a[(i + 1) % a.size()];
+            for (size_t j = 0; j < b.size(); ++j) {
+                if (b[j] == v && b[(j + 1) % b.size()] == u) {
+                    std::vector<int> joined;
+                    for (size_t k = 0; k < a.size(); ++k) {
+                        joined.push_back(a[(i + 1 + k) % a.size()]);  // empieza en v, acaba en u
+                    }
+                    for (size_t k = 2; k < b.size(); ++k) {
+                        joined.push_back(b[(j + k) % b.size()]);  // de b, sin u ni v
+                    }
+                    return joined;
+                }
+            }
+        }
+        return {};
+    }
+
+    int pieceCount = 0;
+    ConvexPiece pieces[HULL_MAX_PIECES];
+    float boundingRadius = 0.0f;
+};
+
+// SAT entre dos piezas convexas ya colocadas en el mundo
+inline bool convexPiecesOverlap(const sf::Vector2f* va, const sf::Vector2f* axesA, int na,
+                                const sf::Vector2f* vb, const sf::Vector2f* axesB, int nb) {
+    auto separated = [&](const sf::Vector2f& axis) {
+        float minA = va[0].x * axis.x + va[0].y * axis.y, maxA = minA;
+        for (int i = 1; i < na; ++i) {
+            float p = va[i].x * axis.x + va[i].y * axis.y;
+            minA = std::min(minA, p);
+            maxA = std::max(maxA, p);
+        }
+        float minB = vb[0].x * axis.x + vb[0].y * axis.y, maxB = minB;
+        for (int i = 1; i < nb; ++i) {
+            float p = vb[i].x * axis.x + vb[i].y * axis.y;
+            minB = std::min(minB, p);
+            maxB = std::max(maxB, p);
+        }
+        return maxA < minB || maxB < minA;
+    };
+    for (int i = 0; i < na; ++i) {
+        if (separated(axesA[i])) {
+            return false;
+        }
+    }
+    for (int i = 0; i < nb; ++i) {
+        if (separated(axesB[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Casco contra casco: círculos envolventes, luego SAT pieza a pieza
+inline bool hullsIntersect(const CollisionHull& a, const HullPose& poseA,
+                           const CollisionHull& b, const HullPose& poseB) {
+    if (!checkCollision(poseA.position, a.getBoundingRadius(), poseB.position, b.getBoundingRadius())) {
+        return false;
+    }
+    for (int i = 0; i < a.getPieceCount(); ++i) {
+        const ConvexPiece& pa = a.getPiece(i);
+        sf::Vector2f centerA = poseA.apply(pa.center);
+        sf::Vector2f vertsA[HULL_MAX_VERTS];
+        sf::Vector2f axesA[HULL_MAX_VERTS];
+        bool placedA = false;
+
+        for (int j = 0; j < b.getPieceCount(); ++j) {
+            const ConvexPiece& pb = b.getPiece(j);
+            sf::Vector2f centerB = poseB.apply(pb.center);
+            if (!checkCollision(centerA, pa.radius, centerB, pb.radius)) {
+                continue;
+            }
+            if (!placedA) {
+                for (int k = 0; k < pa.count; ++k) {
+                    vertsA[k] = poseA.apply(pa.verts[k]);
+                    axesA[k] = poseA.rotate(pa.axes[k]);
+                }
+                placedA = true;
+            }
+            sf::Vector2f vertsB[HULL_MAX_VERTS];
+            sf::Vector2f axesB[HULL_MAX_VERTS];
+            for (int k = 0; k < pb.count; ++k) {
+                vertsB[k] = poseB.apply(pb.verts[k]);
+                axesB[k] = poseB.rotate(pb.axes[k]);
+            }
+            if (convexPiecesOverlap(vertsA, axesA, pa.count, vertsB, axesB, pb.count)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Círculo contra casco. El centro se pasa a espacio local del casco, así que
+// no hay que girar nada del casco; se busca el punto más cercano de cada pieza.
+inline bool circleHullIntersect(const sf::Vector2f& center, float radius,
+                                const CollisionHull& hull, const HullPose& pose) {
+    if (!checkCollision(center, radius, pose.position, hull.getBoundingRadius())) {
+        return false;
+    }
+    sf::Vector2f local = pose.toLocal(center);
+    float radiusSq = radius * radius;
+    for (int i = 0; i < hull.getPieceCount(); ++i) {
+        const ConvexPiece& piece = hull.getPiece(i);
+        if (!checkCollision(local, radius, piece.center, piece.radius)) {
+            continue;
+        }
+        bool inside = true;
+        for (int k = 0; k < piece.count; ++k) {
+            const sf::Vector2f& a = piece.verts[k];
+            const sf::Vector2f& b = piece.verts[(k + 1) % piece.count];
+            sf::Vector2f ap = local - a;
+            if (ap.x * piece.axes[k].x + ap.y * piece.axes[k].y > 0.0f) {
+                inside = false;
+            }
+            // Distancia al cuadrado hasta la arista ab
+            sf::Vector2f ab = b - a;
+            float t = (ap.x * ab.x + ap.y * ab.y) / (ab.x * ab.x + ab.y * ab.y);
+            t = std::min(std::max(t, 0.0f), 1.0f);
+            sf::Vector2f d = ap - ab * t;
+            if (d.x * d.x + d.y * d.y <= radiusSq) {
+                return true;
+            }
+        }
+        if (inside) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Colisión continua -------------------------------------------------------
+// Los tiempos van de 0 (inicio del tick) a 1 (final) y suponen movimiento en
+// línea recta durante el tick, así que no depende de lo grande que sea dt.
+
+// Intervalo [enter, exit] del tick en que dos círculos en movimiento se
+// solapan. 'offset' es la posición de B menos la de A al empezar el tick y
+// 'motion' el desplazamiento de B menos el de A durante el tick.
+inline bool sweptCircleInterval(const sf::Vector2f& offset, const sf::Vector2f& motion, float radiusSum,
+                                float& enter, float& exit) {
+    float a = motion.x * motion.x + motion.y * motion.y;
+    float b = offset.x * motion.x + offset.y * motion.y;
+    float c = offset.x * offset.x + offset.y * offset.y - radiusSum * radiusSum;
+    if (a <= 0.0f) {
+        // Sin movimiento relativo: o se solapan todo el tick o nada
+        enter = 0.0f;
+        exit = 1.0f;
+        return c <= 0.0f;
+    }
+    float disc = b * b - a * c;
+    if (disc < 0.0f) {
+        return false;
+    }
+    float root = std::sqrt(disc);
+    enter = (-b - root) / a;
+    exit = (-b + root) / a;
+    if (enter > 1.0f || exit < 0.0f) {
+        return false;
+    }
+    enter = std::max(enter, 0.0f);
+    exit = std::min(exit, 1.0f);
+    return true;
+}
+
+// Primer instante de [enter, exit] en que 'contact(t)' es cierto, probando
+// 'samples' instantes equiespaciados (incluidos los dos extremos). -1 si no
+// hay contacto en ninguno.
+template <typename Contact>
+float firstContactTime(float enter, float exit, int samples, Contact&& contact) {
+    if (samples < 2 || exit <= enter) {
+        return contact(enter) ? enter : -1.0f;
+    }
+    float stepTime = (exit - enter) / static_cast<float>(samples - 1);
+    for (int i = 0; i < samples; ++i) {
+        float t = i + 1 < samples ? enter + stepTime * static_cast<float>(i) : exit;
+        if (contact(t)) {
+            return t;
+        }
+    }
+    return -1.0f;
+}
+
+// Muestras para recorrer [enter, exit] sin que el movimiento relativo entre
+// dos muestras pase de 'maxStep' (el grosor de lo más fino que se prueba)
+inline int sweepSamples(float enter, float exit, float relativeDistance, float maxStep, int maxSamples = 32) {
+    float distance = relativeDistance * (exit - enter);
+    int samples = static_cast<int>(std::ceil(distance / maxStep)) + 1;
+    return std::min(std::max(samples, 2), maxSamples);
+}
+
+// Clase para manejar métodos de detección de colisión
+class CollisionDriver {
+public:
+    using CollisionMethod = std::function<bool(const std::vector<sf::Vector2f>&, const std::vector<sf::Vector2f>&)>;
+
+    // Método ya resuelto: se obtiene una vez con resolve() y evita buscar
+    // por nombre en cada comprobación
+    struct MethodHandle {
+        size_t index;
+    };
+
+    CollisionDriver() {
+        // Registrar el método SAT por defecto (polígonos convexos)
+        addMethod("sat", polygonIntersectionSAT);
+    }
+
+    void addMethod(const std::string& name, CollisionMethod method) {
+        auto it = indices.find(name);
+        if (it != indices.end()) {
+            methods[it->second] = method;
+        } else {
+            indices[name] = methods.size();
+            methods.push_back(method);
+        }
+    }
+
+    MethodHandle resolve(const std::string& method) const {
+        auto it = indices.find(method);
+        if (it == indices.end()) {
+            throw std::runtime_error("Método no encontrado: " + method);
+        }
+        return { it->second };
+    }
+
+    bool checkCollision(MethodHandle method, const std::vector<sf::Vector2f>& poly1, const std::vector<sf::Vector2f>& poly2) const {
+        return methods[method.index](poly1, poly2);
+    }
+
+    bool checkCollision(const std::string& method, const std::vector<sf::Vector2f>& poly1, const std::vector<sf::Vector2f>& poly2) const {
+        return checkCollision(resolve(method), poly1, poly2);
+    }
+
+    // Implementación del algoritmo SAT (solo es exacto con polígonos convexos;
+    // para cascos cóncavos usar CollisionHull). No reserva memoria ni usa sqrt:
+    // los ejes sin normalizar separan igual que los normalizados.
+    static bool polygonIntersectionSAT(const std::vector<sf::Vector2f>& poly1, const std::vector<sf::Vector2f>& poly2) {
+        auto separatedOnEdgesOf = [&](const std::vector<sf::Vector2f>& poly) {
+            for (size_t i = 0; i < poly.size(); ++i) {
+                const sf::Vector2f& p1 = poly[i];
+                const sf::Vector2f& p2 = poly[(i + 1) % poly.size()];
+                sf::Vector2f axis = { p1.y - p2.y, p2.x - p1.x };
+                float min1, max1, min2, max2;
+                project(poly1, axis, min1, max1);
+                project(poly2, axis, min2, max2);
+                if (max1 < min2 || max2 < min1) {
+                    return true;  // Separación encontrada
+                }
+            }
+            return false;
+        };
+
+        if (poly1.empty() || poly2.empty()) {
+            return false;
+        }
+        return !separatedOnEdgesOf(poly1) && !separatedOnEdgesOf(poly2);
+    }
+
+private:
+    static void project(const std::vector<sf::Vector2f>& poly, const sf::Vector2f& axis, float& min, float& max) {
+        min = max = poly[0].x * axis.x + poly[0].y * axis.y;
+        for (const auto& vertex : poly) {
+            float projection = vertex.x * axis.x + vertex.y * axis.y;
+            if (projection < min) min = projection;
+            if (projection > max) max = projection;
+        }
+    }
+
+    std::map<std::string, size_t> indices;
+    std::vector<CollisionMethod> methods;
+};
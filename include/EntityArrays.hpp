@@ -0,0 +1,387 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AngleMath.hpp"
+#include "LinearArena.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SHOOT_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SHOOT_SIMD_WIDTH 4
+#else
+#define SHOOT_SIMD_WIDTH 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Almacenamiento de entidades en estructura de arrays (SoA).
+// Cada campo vive en su propio array contiguo para que la integración
+// recorra memoria secuencial y se pueda vectorizar. El orden no se
+// conserva: las bajas se hacen con swap-remove.
+//
+// La capacidad es fija. Los arrays y el número de elementos salen de una
+// LinearArena: la del mundo con bind(), o una propia con reserve(). Hasta
+// entonces no hay memoria (ni size()).
+
+// Balas: posición, dirección unitaria y tiempo de vida restante
+struct BulletArrays {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* dx = nullptr;
+    float* dy = nullptr;
+    float* life = nullptr;
+
+    size_t size() const { return *count; }
+
+    // Lo que ocupan n balas en una arena
+    static size_t arenaBytes(size_t n) {
+        return LinearArena::bytesFor<std::uint32_t>(1) + 5 * LinearArena::bytesFor<float>(n);
+    }
+
+    void bind(LinearArena& arena, size_t n) {
+        count = arena.create<std::uint32_t>(0u);
+        x = arena.allocate<float>(n); y = arena.allocate<float>(n);
+        dx = arena.allocate<float>(n); dy = arena.allocate<float>(n);
+        life = arena.allocate<float>(n);
+    }
+
+    void reserve(size_t n) {
+        storage = std::make_unique<LinearArena>(arenaBytes(n));
+        bind(*storage, n);
+    }
+
+    void push(const sf::Vector2f& position, const sf::Vector2f& direction, float lifetime) {
+        size_t i = (*count)++;
+        x[i] = position.x; y[i] = position.y;
+        dx[i] = direction.x; dy[i] = direction.y;
+        life[i] = lifetime;
+    }
+
+    void swapRemove(size_t i) {
+        size_t last = --*count;
+        x[i] = x[last]; y[i] = y[last];
+        dx[i] = dx[last]; dy[i] = dy[last];
+        life[i] = life[last];
+    }
+
+    void clear() {
+        *count = 0;
+    }
+
+    sf::Vector2f position(size_t i) const { return { x[i], y[i] }; }
+
+private:
+    std::unique_ptr<LinearArena> storage;
+    std::uint32_t* count = nullptr;
+};
+
+// Asteroides: posición, dirección unitaria y ángulo de giro (binario)
+struct AsteroidArrays {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* dx = nullptr;
+    float* dy = nullptr;
+    BinaryAngle* angle = nullptr;
+
+    size_t size() const { return *count; }
+
+    // Lo que ocupan n asteroides en una arena
+    static size_t arenaBytes(size_t n) {
+        return LinearArena::bytesFor<std::uint32_t>(1) + 4 * LinearArena::bytesFor<float>(n)
+             + LinearArena::bytesFor<BinaryAngle>(n);
+    }
+
+    void bind(LinearArena& arena, size_t n) {
+        count = arena.create<std::uint32_t>(0u);
+        x = arena.allocate<float>(n); y = arena.allocate<float>(n);
+        dx = arena.allocate<float>(n); dy = arena.allocate<float>(n);
+        angle = arena.allocate<BinaryAngle>(n);
+    }
+
+    void reserve(size_t n) {
+        storage = std::make_unique<LinearArena>(arenaBytes(n));
+        bind(*storage, n);
+    }
+
+    void push(const sf::Vector2f& position, const sf::Vector2f& direction, BinaryAngle startAngle = 0) {
+        size_t i = (*count)++;
+        x[i] = position.x; y[i] = position.y;
+        dx[i] = direction.x; dy[i] = direction.y;
+        angle[i] = startAngle;
+    }
+
+    void swapRemove(size_t i) {
+        size_t last = --*count;
+        x[i] = x[last]; y[i] = y[last];
+        dx[i] = dx[last]; dy[i] = dy[last];
+        angle[i] = angle[last];
+    }
+
+    void clear() {
+        *count = 0;
+    }
+
+    sf::Vector2f position(size_t i) const { return { x[i], y[i] }; }
+
+private:
+    std::unique_ptr<LinearArena> storage;
+    std::uint32_t* count = nullptr;
+};
+
+// Límites del rebote de los asteroides (ya descontado el medio tamaño)
+struct BounceBounds {
+    float minX, maxX;
+    float minY, maxY;
+};
+
+// Kernels de integración --------------------------------------------------
+// Todos aceptan un rango [begin, end) para poder repartirlos entre hilos.
+
+// position += direction * speed * dt; life -= dt
+inline void integrateBullets(BulletArrays& b, float speed, float dt,
+                             size_t begin = 0, size_t end = SIZE_MAX) {
+    const size_t n = std::min(end, b.size());
+    const float step = speed * dt;
+    size_t i = begin;
+#if SHOOT_SIMD_WIDTH == 8
+    const __m256 vStep = _mm256_set1_ps(step);
+    const __m256 vDt = _mm256_set1_ps(dt);
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(&b.x[i]);
+        __m256 y = _mm256_loadu_ps(&b.y[i]);
+        x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(&b.dx[i]), vStep));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(&b.dy[i]), vStep));
+        _mm256_storeu_ps(&b.x[i], x);
+        _mm256_storeu_ps(&b.y[i], y);
+        _mm256_storeu_ps(&b.life[i], _mm256_sub_ps(_mm256_loadu_ps(&b.life[i]), vDt));
+    }
+#elif SHOOT_SIMD_WIDTH == 4
+    const __m128 vStep = _mm_set1_ps(step);
+    const __m128 vDt = _mm_set1_ps(dt);
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(&b.x[i]);
+        __m128 y = _mm_loadu_ps(&b.y[i]);
+        x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&b.dx[i]), vStep));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&b.dy[i]), vStep));
+        _mm_storeu_ps(&b.x[i], x);
+        _mm_storeu_ps(&b.y[i], y);
+        _mm_storeu_ps(&b.life[i], _mm_sub_ps(_mm_loadu_ps(&b.life[i]), vDt));
+    }
+#endif
+    // Resto escalar (y camino completo si no hay SIMD)
+    for (; i < n; ++i) {
+        b.x[i] += b.dx[i] * step;
+        b.y[i] += b.dy[i] * step;
+        b.life[i] -= dt;
+    }
+}
+
+// Un solo asteroide: avanza 'step', gira 'turn' y rebota en los bordes
+inline void integrateAsteroid(AsteroidArrays& a, size_t i, float step, BinaryAngle turn, const BounceBounds& bounds) {
+    a.x[i] += a.dx[i] * step;
+    a.y[i] += a.dy[i] * step;
+    a.angle[i] += turn;
+    if (a.x[i] <= bounds.minX || a.x[i] >= bounds.maxX) {
+        a.dx[i] = -a.dx[i];
+    }
+    if (a.y[i] <= bounds.minY || a.y[i] >= bounds.maxY) {
+        a.dy[i] = -a.dy[i];
+    }
+}
+
+// position += direction * speed * dt; angle += spin * dt; rebote en los bordes.
+// 'spin' va en grados por segundo; el giro se suma como ángulo binario.
+inline void integrateAsteroids(AsteroidArrays& a, float speed, float spin, const BounceBounds& bounds, float dt,
+                               size_t begin = 0, size_t end = SIZE_MAX) {
+    const size_t n = std::min(end, a.size());
+    const float step = speed * dt;
+    const BinaryAngle turn = angleFromDegrees(spin * dt);
+    size_t i = begin;
+#if SHOOT_SIMD_WIDTH == 8
+    const __m256 vStep = _mm256_set1_ps(step);
+    // AVX no tiene sumas enteras de 256 bits: el ángulo va en dos mitades
+    const __m128i vTurn = _mm_set1_epi32(static_cast<int>(turn));
+    const __m256 vSign = _mm256_set1_ps(-0.0f);
+    const __m256 vMinX = _mm256_set1_ps(bounds.minX), vMaxX = _mm256_set1_ps(bounds.maxX);
+    const __m256 vMinY = _mm256_set1_ps(bounds.minY), vMaxY = _mm256_set1_ps(bounds.maxY);
+    for (; i + 8 <= n; i += 8) {
+        __m256 dx = _mm256_loadu_ps(&a.dx[i]);
+        __m256 dy = _mm256_loadu_ps(&a.dy[i]);
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(&a.x[i]), _mm256_mul_ps(dx, vStep));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(&a.y[i]), _mm256_mul_ps(dy, vStep));
+        __m256 hitX = _mm256_or_ps(_mm256_cmp_ps(x, vMinX, _CMP_LE_OQ), _mm256_cmp_ps(x, vMaxX, _CMP_GE_OQ));
+        __m256 hitY = _mm256_or_ps(_mm256_cmp_ps(y, vMinY, _CMP_LE_OQ), _mm256_cmp_ps(y, vMaxY, _CMP_GE_OQ));
+        _mm256_storeu_ps(&a.x[i], x);
+        _mm256_storeu_ps(&a.y[i], y);
+        _mm256_storeu_ps(&a.dx[i], _mm256_xor_ps(dx, _mm256_and_ps(hitX, vSign)));
+        _mm256_storeu_ps(&a.dy[i], _mm256_xor_ps(dy, _mm256_and_ps(hitY, vSign)));
+        __m128i* angle = reinterpret_cast<__m128i*>(&a.angle[i]);
+        _mm_storeu_si128(angle, _mm_add_epi32(_mm_loadu_si128(angle), vTurn));
+        _mm_storeu_si128(angle + 1, _mm_add_epi32(_mm_loadu_si128(angle + 1), vTurn));
+    }
+#elif SHOOT_SIMD_WIDTH == 4
+    const __m128 vStep = _mm_set1_ps(step);
+    const __m128i vTurn = _mm_set1_epi32(static_cast<int>(turn));
+    const __m128 vSign = _mm_set1_ps(-0.0f);
+    const __m128 vMinX = _mm_set1_ps(bounds.minX), vMaxX = _mm_set1_ps(bounds.maxX);
+    const __m128 vMinY = _mm_set1_ps(bounds.minY), vMaxY = _mm_set1_ps(bounds.maxY);
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_loadu_ps(&a.dx[i]);
+        __m128 dy = _mm_loadu_ps(&a.dy[i]);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(&a.x[i]), _mm_mul_ps(dx, vStep));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(&a.y[i]), _mm_mul_ps(dy, vStep));
+        __m128 hitX = _mm_or_ps(_mm_cmple_ps(x, vMinX), _mm_cmpge_ps(x, vMaxX));
+        __m128 hitY = _mm_or_ps(_mm_cmple_ps(y, vMinY), _mm_cmpge_ps(y, vMaxY));
+        _mm_storeu_ps(&a.x[i], x);
+        _mm_storeu_ps(&a.y[i], y);
+        _mm_storeu_ps(&a.dx[i], _mm_xor_ps(dx, _mm_and_ps(hitX, vSign)));
+        _mm_storeu_ps(&a.dy[i], _mm_xor_ps(dy, _mm_and_ps(hitY, vSign)));
+        __m128i* angle = reinterpret_cast<__m128i*>(&a.angle[i]);
+        _mm_storeu_si128(angle, _mm_add_epi32(_mm_loadu_si128(angle), vTurn));
+    }
+#endif
+    for (; i < n; ++i) {
+        integrateAsteroid(a, i, step, turn, bounds);
+    }
+}
+
+// Como integrateAsteroids, pero a dos ritmos: los asteroides dentro de
+// 'active' avanzan un paso; los de fuera, solo en los ticks en que
+// (slots[i] & (interval - 1)) == phase, y entonces 'interval' pasos de golpe
+// (los demás ni se mueven ni rebotan). 'slots' es el slot de cada índice
+// denso e 'interval', una potencia de dos.
+inline void integrateAsteroidsStaggered(AsteroidArrays& a, const std::uint32_t* slots, const BounceBounds& active,
+                                        std::uint32_t interval, std::uint32_t phase, float step, BinaryAngle turn,
+                                        const BounceBounds& bounds, size_t begin = 0, size_t end = SIZE_MAX) {
+    const size_t n = std::min(end, a.size());
+    const std::uint32_t mask = interval - 1;
+    const float farStep = step * static_cast<float>(interval);
+    const BinaryAngle farTurn = turn * interval;
+    size_t i = begin;
+#if SHOOT_SIMD_WIDTH >= 4
+    // El slot y el ángulo son enteros: van en bloques de 128 bits también con AVX
+    const __m128i vMask = _mm_set1_epi32(static_cast<int>(mask));
+    const __m128i vPhase = _mm_set1_epi32(static_cast<int>(phase));
+    const __m128i vTurn = _mm_set1_epi32(static_cast<int>(turn));
+    const __m128i vFarTurn = _mm_set1_epi32(static_cast<int>(farTurn));
+    // Carriles cuyo slot toca avanzar en este tick
+    auto due = [&](size_t k) {
+        return _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&slots[k])), vMask), vPhase);
+    };
+    // Giro de cada carril: 'turn' si está cerca, 'farTurn' si le toca, nada si no
+    auto spin = [&](size_t k, __m128i isNear, __m128i isDue) {
+        __m128i laneTurn = _mm_or_si128(_mm_and_si128(isNear, vTurn), _mm_andnot_si128(isNear, _mm_and_si128(isDue, vFarTurn)));
+        __m128i* angle = reinterpret_cast<__m128i*>(&a.angle[k]);
+        _mm_storeu_si128(angle, _mm_add_epi32(_mm_loadu_si128(angle), laneTurn));
+    };
+#endif
+#if SHOOT_SIMD_WIDTH == 8
+    const __m256 vStep = _mm256_set1_ps(step), vFarStep = _mm256_set1_ps(farStep);
+    const __m256 vSign = _mm256_set1_ps(-0.0f);
+    const __m256 vMinX = _mm256_set1_ps(bounds.minX), vMaxX = _mm256_set1_ps(bounds.maxX);
+    const __m256 vMinY = _mm256_set1_ps(bounds.minY), vMaxY = _mm256_set1_ps(bounds.maxY);
+    const __m256 vActiveMinX = _mm256_set1_ps(active.minX), vActiveMaxX = _mm256_set1_ps(active.maxX);
+    const __m256 vActiveMinY = _mm256_set1_ps(active.minY), vActiveMaxY = _mm256_set1_ps(active.maxY);
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(&a.x[i]);
+        __m256 y = _mm256_loadu_ps(&a.y[i]);
+        __m256 isNear = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(x, vActiveMinX, _CMP_GE_OQ), _mm256_cmp_ps(x, vActiveMaxX, _CMP_LE_OQ)),
+                                      _mm256_and_ps(_mm256_cmp_ps(y, vActiveMinY, _CMP_GE_OQ), _mm256_cmp_ps(y, vActiveMaxY, _CMP_LE_OQ)));
+        __m128i dueLow = due(i), dueHigh = due(i + 4);
+        __m256 isDue = _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(dueLow), dueHigh, 1));
+        __m256 laneStep = _mm256_or_ps(_mm256_and_ps(isNear, vStep), _mm256_andnot_ps(isNear, _mm256_and_ps(isDue, vFarStep)));
+        __m256 moved = _mm256_or_ps(isNear, isDue);
+        __m256 dx = _mm256_loadu_ps(&a.dx[i]);
+        __m256 dy = _mm256_loadu_ps(&a.dy[i]);
+        x = _mm256_add_ps(x, _mm256_mul_ps(dx, laneStep));
+        y = _mm256_add_ps(y, _mm256_mul_ps(dy, laneStep));
+        __m256 hitX = _mm256_or_ps(_mm256_cmp_ps(x, vMinX, _CMP_LE_OQ), _mm256_cmp_ps(x, vMaxX, _CMP_GE_OQ));
+        __m256 hitY = _mm256_or_ps(_mm256_cmp_ps(y, vMinY, _CMP_LE_OQ), _mm256_cmp_ps(y, vMaxY, _CMP_GE_OQ));
+        _mm256_storeu_ps(&a.x[i], x);
+        _mm256_storeu_ps(&a.y[i], y);
+        _mm256_storeu_ps(&a.dx[i], _mm256_xor_ps(dx, _mm256_and_ps(_mm256_and_ps(hitX, moved), vSign)));
+        _mm256_storeu_ps(&a.dy[i], _mm256_xor_ps(dy, _mm256_and_ps(_mm256_and_ps(hitY, moved), vSign)));
+        __m256i nearBits = _mm256_castps_si256(isNear);
+        spin(i, _mm256_castsi256_si128(nearBits), dueLow);
+        spin(i + 4, _mm256_extractf128_si256(nearBits, 1), dueHigh);
+    }
+#elif SHOOT_SIMD_WIDTH == 4
+    const __m128 vStep = _mm_set1_ps(step), vFarStep = _mm_set1_ps(farStep);
+    const __m128 vSign = _mm_set1_ps(-0.0f);
+    const __m128 vMinX = _mm_set1_ps(bounds.minX), vMaxX = _mm_set1_ps(bounds.maxX);
+    const __m128 vMinY = _mm_set1_ps(bounds.minY), vMaxY = _mm_set1_ps(bounds.maxY);
+    const __m128 vActiveMinX = _mm_set1_ps(active.minX), vActiveMaxX = _mm_set1_ps(active.maxX);
+    const __m128 vActiveMinY = _mm_set1_ps(active.minY), vActiveMaxY = _mm_set1_ps(active.maxY);
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(&a.x[i]);
+        __m128 y = _mm_loadu_ps(&a.y[i]);
+        __m128 isNear = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, vActiveMinX), _mm_cmple_ps(x, vActiveMaxX)),
+                                   _mm_and_ps(_mm_cmpge_ps(y, vActiveMinY), _mm_cmple_ps(y, vActiveMaxY)));
+        __m128i dueBits = due(i);
+        __m128 isDue = _mm_castsi128_ps(dueBits);
+        __m128 laneStep = _mm_or_ps(_mm_and_ps(isNear, vStep), _mm_andnot_ps(isNear, _mm_and_ps(isDue, vFarStep)));
+        __m128 moved = _mm_or_ps(isNear, isDue);
+        __m128 dx = _mm_loadu_ps(&a.dx[i]);
+        __m128 dy = _mm_loadu_ps(&a.dy[i]);
+        x = _mm_add_ps(x, _mm_mul_ps(dx, laneStep));
+        y = _mm_add_ps(y, _mm_mul_ps(dy, laneStep));
+        __m128 hitX = _mm_or_ps(_mm_cmple_ps(x, vMinX), _mm_cmpge_ps(x, vMaxX));
+        __m128 hitY = _mm_or_ps(_mm_cmple_ps(y, vMinY), _mm_cmpge_ps(y, vMaxY));
+        _mm_storeu_ps(&a.x[i], x);
+        _mm_storeu_ps(&a.y[i], y);
+        _mm_storeu_ps(&a.dx[i], _mm_xor_ps(dx, _mm_and_ps(_mm_and_ps(hitX, moved), vSign)));
+        _mm_storeu_ps(&a.dy[i], _mm_xor_ps(dy, _mm_and_ps(_mm_and_ps(hitY, moved), vSign)));
+        spin(i, _mm_castps_si128(isNear), dueBits);
+    }
+#endif
+    for (; i < n; ++i) {
+        if (a.x[i] >= active.minX && a.x[i] <= active.maxX && a.y[i] >= active.minY && a.y[i] <= active.maxY) {
+            integrateAsteroid(a, i, step, turn, bounds);
+        } else if ((slots[i] & mask) == phase) {
+            integrateAsteroid(a, i, farStep, farTurn, bounds);
+        }
+    }
+}
+
+// Posición del bit más bajo a 1 de 'mask' (que no puede ser 0)
+inline int lowestBit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Añade a 'out' los índices de las balas cuya vida se ha agotado
+inline void collectExpiredBullets(const BulletArrays& b, std::vector<std::uint32_t>& out,
+                                  size_t begin = 0, size_t end = SIZE_MAX) {
+    const size_t n = std::min(end, b.size());
+    size_t i = begin;
+#if SHOOT_SIMD_WIDTH >= 4
+    const __m128 vZero = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&b.life[i]), vZero));
+        while (mask) {
+            int lane = lowestBit(static_cast<unsigned>(mask));
+            out.push_back(static_cast<std::uint32_t>(i + lane));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (b.life[i] <= 0.0f) {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
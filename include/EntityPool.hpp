@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include "LinearArena.hpp"
+
+// Handle generacional: índice de slot + generación.
+// Un handle deja de ser válido en cuanto su entidad se elimina, aunque el
+// slot se reutilice después, así que matar dos veces lo mismo es inofensivo.
+struct EntityHandle {
+    static constexpr std::uint32_t INVALID = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t slot = INVALID;
+    std::uint32_t generation = 0;
+
+    bool valid() const { return slot != INVALID; }
+
+    bool operator==(const EntityHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Slot map de capacidad fija: traduce handles a índices del array denso.
+// Alta y baja en O(1). La memoria sale de una LinearArena (la propia si se
+// crea solo con la capacidad) y todo su estado vive en ella, así que una foto
+// de la arena incluye el slot map.
+//
+// Los slots se estrenan por orden (hasta 'highWater') y los liberados se
+// reutilizan antes. Vaciar es O(1): basta con bajar 'highWater' a cero. Un
+// slot al estrenarse sube su generación, de modo que los handles de antes
+// del vaciado no vuelven a ser válidos.
+class SlotMap {
+public:
+    // Sin memoria hasta bind()
+    SlotMap() = default;
+
+    // Con una arena propia
+    explicit SlotMap(std::uint32_t capacity)
+        : storage(std::make_unique<LinearArena>(arenaBytes(capacity))) {
+        bind(*storage, capacity);
+    }
+
+    // Lo que ocupa en una arena
+    static std::size_t arenaBytes(std::uint32_t capacity) {
+        return LinearArena::bytesFor<Header>(1) + LinearArena::bytesFor<Slot>(capacity)
+             + LinearArena::bytesFor<std::uint32_t>(capacity);
+    }
+
+    // Toma su memoria de 'arena' y empieza vacío
+    void bind(LinearArena& arena, std::uint32_t capacity) {
+        header = arena.create<Header>();
+        slots = arena.allocate<Slot>(capacity);
+        denseToSlot = arena.allocate<std::uint32_t>(capacity);
+        slotCapacity = capacity;
+    }
+
+    std::uint32_t capacity() const { return slotCapacity; }
+    std::uint32_t size() const { return header->count; }
+    bool full() const { return header->count == slotCapacity; }
+
+    // Ocupa un slot para el elemento que se acaba de añadir al final del array denso
+    EntityHandle insert() {
+        std::uint32_t slot = header->freeHead;
+        if (slot != EntityHandle::INVALID) {
+            header->freeHead = slots[slot].next;
+        } else {
+            slot = header->highWater++;
+            ++slots[slot].generation;
+        }
+        Slot& s = slots[slot];
+        s.dense = header->count;
+        denseToSlot[header->count] = slot;
+        ++header->count;
+        return { slot, s.generation };
+    }
+
+    bool contains(const EntityHandle& h) const {
+        return h.slot < header->highWater && slots[h.slot].generation == h.generation
+            && slots[h.slot].dense != EntityHandle::INVALID;
+    }
+
+    // Libera el slot y devuelve su índice denso. El llamador debe hacer
+    // swap-remove de ese índice en sus arrays (el último pasa a ocupar el hueco).
+    std::uint32_t remove(const EntityHandle& h) {
+        Slot& s = slots[h.slot];
+        std::uint32_t dense = s.dense;
+        std::uint32_t last = header->count - 1;
+        std::uint32_t movedSlot = denseToSlot[last];
+        denseToSlot[dense] = movedSlot;
+        slots[movedSlot].dense = dense;
+
+        s.dense = EntityHandle::INVALID;
+        ++s.generation;
+        s.next = header->freeHead;
+        header->freeHead = h.slot;
+        --header->count;
+        return dense;
+    }
+
+    // Slot de cada elemento denso, en orden denso
+    const std::uint32_t* denseSlots() const {
+        return denseToSlot;
+    }
+
+    EntityHandle handleAt(std::uint32_t dense) const {
+        std::uint32_t slot = denseToSlot[dense];
+        return { slot, slots[slot].generation };
+    }
+
+    std::uint32_t indexOf(const EntityHandle& h) const {
+        return slots[h.slot].dense;
+    }
+
+    // Invalida todos los handles vivos
+    void clear() {
+        *header = Header();
+    }
+
+private:
+    // Los campos de los slots no se inicializan: hasta estrenarse (highWater)
+    // no se leen, y la generación sigue subiendo de un vaciado a otro
+    struct Slot {
+        std::uint32_t dense;
+        std::uint32_t generation;
+        std::uint32_t next;
+    };
+
+    struct Header {
+        std::uint32_t count = 0;
+        std::uint32_t freeHead = EntityHandle::INVALID;
+        std::uint32_t highWater = 0;
+    };
+
+    std::unique_ptr<LinearArena> storage;
+    Header* header = nullptr;
+    Slot* slots = nullptr;
+    std::uint32_t* denseToSlot = nullptr;
+    std::uint32_t slotCapacity = 0;
+};
+
+// Pool de capacidad fija sobre unos arrays SoA (BulletArrays, AsteroidArrays...).
+// Los datos siguen densos para los kernels; las altas fallan si el pool está
+// lleno en lugar de reservar memoria. Con una arena, el slot map y los arrays
+// salen de ella (ver Simulation); si no, cada uno reserva la suya.
+template <typename Arrays>
+class EntityPool {
+public:
+    // Sin memoria hasta bind()
+    EntityPool() = default;
+
+    explicit EntityPool(std::uint32_t capacity) : slots(capacity) {
+        arrays.reserve(capacity);
+    }
+
+    // Lo que ocupa en una arena
+    static std::size_t arenaBytes(std::uint32_t capacity) {
+        return SlotMap::arenaBytes(capacity) + Arrays::arenaBytes(capacity);
+    }
+
+    // Toma su memoria de 'arena' y empieza vacío
+    void bind(LinearArena& arena, std::uint32_t capacity) {
+        slots.bind(arena, capacity);
+        arrays.bind(arena, capacity);
+    }
+
+    template <typename... Args>
+    EntityHandle spawn(Args&&... args) {
+        if (slots.full()) {
+            return {};
+        }
+        arrays.push(std::forward<Args>(args)...);
+        return slots.insert();
+    }
+
+    // Devuelve false si el handle ya estaba muerto (doble baja)
+    bool kill(const EntityHandle& h) {
+        if (!slots.contains(h)) {
+            return false;
+        }
+        arrays.swapRemove(slots.remove(h));
+        return true;
+    }
+
+    bool alive(const EntityHandle& h) const { return slots.contains(h); }
+    EntityHandle handleAt(size_t dense) const { return slots.handleAt(static_cast<std::uint32_t>(dense)); }
+    const std::uint32_t* denseSlots() const { return slots.denseSlots(); }
+    // Índice denso de un handle vivo (en los arrays)
+    size_t indexOf(const EntityHandle& h) const { return slots.indexOf(h); }
+    size_t size() const { return arrays.size(); }
+    std::uint32_t capacity() const { return slots.capacity(); }
+
+    void clear() {
+        arrays.clear();
+        slots.clear();
+    }
+
+    Arrays arrays;
+
+private:
+    SlotMap slots;
+};
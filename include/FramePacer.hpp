@@ -0,0 +1,155 @@
+#pragma once
+
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Time.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Ritmo del bucle de render. Cada frame tiene un plazo (el anterior más el
+// periodo) y wait() espera hasta él en dos partes: duerme hasta poco antes
+// y gira el último tramo, así que el plazo se cumple con precisión de
+// microsegundos sin gastar un núcleo. El tramo de giro se ajusta solo a lo
+// que se pasa de verdad el sueño del sistema (sf::sleep pide al sistema
+// resolución de 1 ms en Windows).
+//
+// Hay dos ritmos: el normal mientras algo se mueve y uno bajo para las
+// pantallas quietas (título, game over), donde el bucle casi no usa CPU.
+
+constexpr double FRAME_IDLE_FPS = 10.0;
+// Límites del tramo que se gira en lugar de dormir (segundos)
+constexpr double FRAME_SPIN_MIN = 0.0002;
+constexpr double FRAME_SPIN_MAX = 0.004;
+// Frames activos que se guardan para los percentiles del jitter
+constexpr std::size_t FRAME_PACER_SAMPLES = 600;
+
+struct FramePacerStats {
+    std::uint64_t frames = 0;      // Frames activos esperados
+    std::uint64_t idleFrames = 0;
+    std::uint64_t missed = 0;      // Frames activos que acabaron después de su plazo
+    double sleptSeconds = 0.0;
+    double spunSeconds = 0.0;
+};
+
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // targetFps 0: sin límite (wait() no espera en los frames activos)
+    explicit FramePacer(double targetFps = 60.0, double idleFps = FRAME_IDLE_FPS)
+        : activePeriod(periodOf(targetFps)), idlePeriod(periodOf(idleFps)), deadline(Clock::now()) {
+        jitter.reserve(FRAME_PACER_SAMPLES);
+        scratch.reserve(FRAME_PACER_SAMPLES);
+    }
+
+    // Si este frame anima algo o la pantalla está quieta
+    void setActive(bool value) {
+        active = value;
+    }
+
+    // Espera hasta el plazo del frame actual y fija el del siguiente
+    void wait() {
+        const double period = active ? activePeriod : idlePeriod;
+        Clock::time_point now = Clock::now();
+        if (period <= 0.0) {
+            deadline = now;
+            countFrame(0.0);
+            return;
+        }
+        deadline += toDuration(period);
+
+        // Frame tarde: se cuenta y no se intenta recuperar el tiempo perdido
+        // (eso serían varios frames seguidos sin espera)
+        if (now >= deadline) {
+            if (active) {
+                stats.missed++;
+            }
+            countFrame(seconds(deadline, now));
+            deadline = now;
+            return;
+        }
+
+        Clock::time_point sleepUntil = deadline - toDuration(spinMargin);
+        if (now < sleepUntil) {
+            sf::sleep(sf::microseconds(static_cast<sf::Int64>(seconds(now, sleepUntil) * 1e6)));
+            Clock::time_point woke = Clock::now();
+            stats.sleptSeconds += seconds(now, woke);
+            adaptSpin(seconds(sleepUntil, woke));
+            now = woke;
+        }
+        Clock::time_point spinStart = now;
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+        stats.spunSeconds += seconds(spinStart, now);
+        countFrame(seconds(deadline, now));
+    }
+
+    // Percentil p (0..1) del retraso sobre el plazo en los últimos frames
+    // activos, en milisegundos
+    double jitterPercentile(double p) {
+        if (jitter.empty()) {
+            return 0.0;
+        }
+        scratch.assign(jitter.begin(), jitter.end());
+        std::size_t k = std::min(scratch.size() - 1, static_cast<std::size_t>(p * (scratch.size() - 1) + 0.5));
+        std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+        return scratch[k] * 1000.0;
+    }
+
+    double targetFps() const { return activePeriod > 0.0 ? 1.0 / activePeriod : 0.0; }
+    double spinSeconds() const { return spinMargin; }
+
+    FramePacerStats stats;
+
+private:
+    static double periodOf(double fps) {
+        return fps > 0.0 ? 1.0 / fps : 0.0;
+    }
+
+    static Clock::duration toDuration(double secondsValue) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(secondsValue));
+    }
+
+    static double seconds(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double>(to - from).count();
+    }
+
+    // El tramo de giro sube en cuanto un sueño se pasa más de la cuenta y
+    // baja poco a poco si el sistema despierta a tiempo
+    void adaptSpin(double overshoot) {
+        if (overshoot > spinMargin) {
+            spinMargin = overshoot * 1.25;
+        } else {
+            spinMargin += (overshoot * 1.25 - spinMargin) * 0.02;
+        }
+        spinMargin = std::min(std::max(spinMargin, FRAME_SPIN_MIN), FRAME_SPIN_MAX);
+    }
+
+    void countFrame(double late) {
+        if (!active) {
+            stats.idleFrames++;
+            return;
+        }
+        stats.frames++;
+        if (jitter.size() < FRAME_PACER_SAMPLES) {
+            jitter.push_back(late);
+        } else {
+            jitter[nextSample] = late;
+        }
+        nextSample = (nextSample + 1) % FRAME_PACER_SAMPLES;
+    }
+
+    double activePeriod;
+    double idlePeriod;
+    bool active = true;
+    double spinMargin = 0.001;
+    Clock::time_point deadline;
+    std::vector<double> jitter;
+    std::vector<double> scratch;
+    std::size_t nextSample = 0;
+};
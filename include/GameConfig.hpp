@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+// Constantes
+constexpr float SCREEN_WIDTH = 1200.0f;
+constexpr float SCREEN_HEIGHT = 900.0f;
+constexpr float M_P = 3.14159265f;
+
+constexpr float PLAYER_W = 50.0f;
+constexpr float PLAYER_H = 40.0f;
+constexpr float TURN_SPEED = 200.0f;
+constexpr float PLAYER_SPEED = 200.0f;
+constexpr float SHOOT_DELAY = 0.2f;
+constexpr float BULLET_SPEED = 400.0f;
+constexpr float BULLET_LIFE = 3.0f;
+constexpr float BULLET_RADIUS = 5.0f;
+
+constexpr float ASTEROID_W = 90.0f;
+constexpr float ASTEROID_H = 80.0f;
+constexpr float ASTEROID_SPIN = 25.0f;
+constexpr float ASTEROID_SPEED = 280.0f;
+constexpr float ASTEROID_SPAWN_TIME = 3.0f;
+
+// Capacidad fija de los pools de entidades
+constexpr std::uint32_t MAX_BULLETS = 1 << 16;
+constexpr std::uint32_t MAX_ASTEROIDS = 1 << 16;
+
+// Paso fijo de la simulación
+constexpr float SIM_DT = 1.0f / 60.0f;
+
+// Vértices del casco de un asteroide y de la nave
+const sf::Vector2f ASTEROID_HULL[] = {
+    { -40, 40 }, { -50, 10 }, { -10, -20 }, { -20, -40 }, { 10, -40 }, { 40, -20 },
+    { 40, -10 }, { 10, 0 }, { 40, 20 }, { 20, 40 }, { 0, 30 }, { -40, 40 }
+};
+const sf::Vector2f PLAYER_HULL[] = {
+    { 20, 0 }, { -30, -20 }, { -15, 0 }, { -30, 20 }, { 20, 0 }
+};
@@ -1,18 +1,25 @@
+#pragma once
+
 #include <chipmunk/chipmunk.h>
 
 class Suelo {
 public:
-    Suelo(cpSpace* space) {
+    Suelo(cpSpace* space) : space(space) {
         cpBody* ground = cpSpaceGetStaticBody(space);
         shape = cpSegmentShapeNew(ground, cpv(0, 500), cpv(800, 500), 0);
         cpShapeSetFriction(shape, 1.0);
         cpSpaceAddShape(space, shape);
     }
 
+    Suelo(const Suelo&) = delete;
+    Suelo& operator=(const Suelo&) = delete;
+
     ~Suelo() {
+        cpSpaceRemoveShape(space, shape);
         cpShapeFree(shape);
     }
 
 private:
+    cpSpace* space;
     cpShape* shape;
-};
\ No newline at end of file
+};
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "GameConfig.hpp"
+#include "Simulation.hpp"
+
+// Grabación de partidas: la semilla, la configuración y la entrada de cada
+// tick de sesión comprimida por tramos (run-length), más un hash del estado
+// cada cierto número de ticks para comprobar que la repetición sale igual.
+//
+// Un "frame de sesión" es un byte: los bits de entrada de la simulación
+// (InputBits) más dos órdenes, empezar y reiniciar, que antes llegaban por
+// eventos de la ventana. Con la misma semilla y los mismos frames la
+// partida se reproduce exactamente.
+
+enum SessionBits : std::uint8_t {
+    SESSION_START = 1 << 6,    // Enter en la pantalla de inicio
+    SESSION_RESTART = 1 << 7   // P en el game over
+};
+
+constexpr std::uint8_t SESSION_INPUT_MASK = INPUT_LEFT | INPUT_RIGHT | INPUT_THRUST | INPUT_FIRE;
+
+// Aplica las órdenes de un frame de sesión: empieza la partida o la
+// reinicia si había terminado. true si la partida está en marcha y al frame
+// le toca un tick.
+template <typename World>
+bool applySessionControl(World& world, bool& started, std::uint8_t frame) {
+    if (frame & SESSION_START) {
+        started = true;
+    }
+    if ((frame & SESSION_RESTART) && world.gameOver) {
+        world.restart();
+    }
+    return started && !world.gameOver;
+}
+
+// Frame completo: órdenes y, si toca, un tick con sus bits de entrada
+template <typename World>
+bool applySessionFrame(World& world, bool& started, std::uint8_t frame, float dt) {
+    if (!applySessionControl(world, started, frame)) {
+        return false;
+    }
+    world.step(frame & SESSION_INPUT_MASK, dt);
+    return true;
+}
+
+// Hash FNV-1a del estado visible de un mundo (jugador, entidades, puntaje)
+template <typename World>
+std::uint64_t hashWorldState(const World& world) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    auto mixFloats = [&mix](const float* values, std::size_t count) {
+        if (count > 0) {
+            mix(values, count * sizeof(float));
+        }
+    };
+    std::int32_t score = world.score;
+    std::uint8_t gameOver = world.gameOver ? 1 : 0;
+    mix(&world.tick, sizeof(world.tick));
+    mix(&score, sizeof(score));
+    mix(&gameOver, sizeof(gameOver));
+    mix(&world.player.position.x, sizeof(float));
+    mix(&world.player.position.y, sizeof(float));
+    mix(&world.player.angle, sizeof(world.player.angle));
+    mix(&world.player.shootTimer, sizeof(float));
+    const BulletArrays& b = world.bullets.arrays;
+    mixFloats(b.x, b.size()); mixFloats(b.y, b.size()); mixFloats(b.dx, b.size());
+    mixFloats(b.dy, b.size()); mixFloats(b.life, b.size());
+    const AsteroidArrays& a = world.asteroids.arrays;
+    mixFloats(a.x, a.size()); mixFloats(a.y, a.size()); mixFloats(a.dx, a.size());
+    mixFloats(a.dy, a.size());
+    mix(a.angle, a.size() * sizeof(BinaryAngle));
+    return hash;
+}
+
+// Tramo de frames iguales
+struct InputRun {
+    std::uint8_t frame;
+    std::uint32_t length;
+};
+
+// Hash del estado tras aplicar 'frames' frames de sesión
+struct StateCheckpoint {
+    std::uint64_t frames;
+    std::uint64_t hash;
+};
+
+constexpr char RECORDING_MAGIC[4] = { 'S', 'H', 'R', 'C' };
+// 2: ángulos binarios (las grabaciones de la versión 1 ya no se reproducen igual)
+// 3: tamaño del mundo y ritmo de los asteroides lejanos en la cabecera
+constexpr std::uint32_t RECORDING_VERSION = 3;
+constexpr std::uint64_t RECORDING_CHECKPOINT_INTERVAL = 60;
+// Lado máximo del mundo que se acepta al leer (la rejilla crece con el área)
+constexpr float RECORDING_MAX_WORLD_SIZE = 65536.0f;
+// Ticks por segundo máximos (dt mínimo) que se aceptan al leer
+constexpr float RECORDING_MAX_TICK_RATE = 1e6f;
+
+// Mundo con el que se grabó (las repeticiones solo cuadran con el mismo)
+enum class RecordingBackend : std::uint8_t {
+    Simulation = 0,
+    Chipmunk = 1
+};
+
+class InputRecording {
+public:
+    // Cabecera: todo lo necesario para volver a crear la misma partida
+    std::uint32_t seed = 0;
+    float dt = SIM_DT;
+    SimConfig config;
+    RecordingBackend backend = RecordingBackend::Simulation;
+
+    std::vector<InputRun> runs;
+    std::vector<StateCheckpoint> checkpoints;
+
+    std::uint64_t frameCount() const { return frames; }
+
+    void append(std::uint8_t frame) {
+        if (!runs.empty() && runs.back().frame == frame && runs.back().length < UINT32_MAX) {
+            ++runs.back().length;
+        } else {
+            runs.push_back({ frame, 1 });
+        }
+        ++frames;
+    }
+
+    void addCheckpoint(std::uint64_t hash) {
+        checkpoints.push_back({ frames, hash });
+    }
+
+    // Formato (little-endian):
+    //   "SHRC" | versión u32 | semilla u32 | dt f32 | asteroidSpawnTime f32 |
+    //   initialAsteroids u32 | maxBullets u32 | maxAsteroids u32 |
+    //   invulnerable u8 | backend u8 | worldWidth f32 | worldHeight f32 |
+    //   farTickInterval u32 |
+    //   nº tramos varint | (frame u8, longitud varint)* |
+    //   nº checkpoints varint | (frames desde el anterior varint, hash u64)*
+    bool save(const std::string& path) const {
+        std::vector<char> out;
+        out.insert(out.end(), RECORDING_MAGIC, RECORDING_MAGIC + sizeof(RECORDING_MAGIC));
+        writeRaw(out, RECORDING_VERSION);
+        writeRaw(out, seed);
+        writeRaw(out, dt);
+        writeRaw(out, config.asteroidSpawnTime);
+        writeRaw(out, config.initialAsteroids);
+        writeRaw(out, config.maxBullets);
+        writeRaw(out, config.maxAsteroids);
+        writeRaw(out, static_cast<std::uint8_t>(config.invulnerable ? 1 : 0));
+        writeRaw(out, static_cast<std::uint8_t>(backend));
+        writeRaw(out, config.worldWidth);
+        writeRaw(out, config.worldHeight);
+        writeRaw(out, config.farTickInterval);
+        writeVarint(out, runs.size());
+        for (const auto& run : runs) {
+            out.push_back(static_cast<char>(run.frame));
+            writeVarint(out, run.length);
+        }
+        writeVarint(out, checkpoints.size());
+        std::uint64_t previous = 0;
+        for (const auto& checkpoint : checkpoints) {
+            writeVarint(out, checkpoint.frames - previous);
+            writeRaw(out, checkpoint.hash);
+            previous = checkpoint.frames;
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(out.data(), static_cast<std::streamsize>(out.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Reader in{ data, 0 };
+
+        char magic[4];
+        std::uint32_t version = 0;
+        std::uint8_t invulnerable = 0;
+        std::uint8_t backendId = 0;
+        if (!in.bytes(magic, sizeof(magic)) || std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0
+            || !in.raw(version) || version != RECORDING_VERSION
+            || !in.raw(seed) || !in.raw(dt) || !in.raw(config.asteroidSpawnTime)
+            || !in.raw(config.initialAsteroids) || !in.raw(config.maxBullets) || !in.raw(config.maxAsteroids)
+            || !in.raw(invulnerable) || !in.raw(backendId)
+            || !in.raw(config.worldWidth) || !in.raw(config.worldHeight) || !in.raw(config.farTickInterval)
+            || !validHeader(backendId)) {
+            return false;
+        }
+        config.invulnerable = invulnerable != 0;
+        backend = static_cast<RecordingBackend>(backendId);
+
+        std::uint64_t count = 0;
+        runs.clear();
+        frames = 0;
+        if (!in.varint(count)) {
+            return false;
+        }
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::uint8_t frame = 0;
+            std::uint64_t length = 0;
+            if (!in.raw(frame) || !in.varint(length) || length == 0 || length > UINT32_MAX) {
+                return false;
+            }
+            runs.push_back({ frame, static_cast<std::uint32_t>(length) });
+            frames += length;
+        }
+
+        checkpoints.clear();
+        if (!in.varint(count)) {
+            return false;
+        }
+        std::uint64_t position = 0;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::uint64_t delta = 0;
+            std::uint64_t hash = 0;
+            if (!in.varint(delta) || !in.raw(hash)) {
+                return false;
+            }
+            position += delta;
+            checkpoints.push_back({ position, hash });
+        }
+        return true;
+    }
+
+private:
+    // La cabecera dimensiona la arena y la rejilla: un archivo corrupto no
+    // puede pedir pools, mundos o pasos fuera de lo que graban el juego y
+    // shoot_headless
+    bool validHeader(std::uint8_t backendId) const {
+        auto inRange = [](float value, float min, float max) {
+            return std::isfinite(value) && value >= min && value <= max;
+        };
+        return inRange(dt, 1.0f / RECORDING_MAX_TICK_RATE, 1.0f)
+            && std::isfinite(config.asteroidSpawnTime) && config.asteroidSpawnTime >= 0.0f
+            && config.maxBullets >= 1 && config.maxBullets <= MAX_BULLETS
+            && config.maxAsteroids >= 1 && config.maxAsteroids <= MAX_ASTEROIDS
+            && inRange(config.worldWidth, SCREEN_WIDTH, RECORDING_MAX_WORLD_SIZE)
+            && inRange(config.worldHeight, SCREEN_HEIGHT, RECORDING_MAX_WORLD_SIZE)
+            && config.farTickInterval != 0 && (config.farTickInterval & (config.farTickInterval - 1)) == 0
+            && backendId <= static_cast<std::uint8_t>(RecordingBackend::Chipmunk);
+    }
+
+    struct Reader {
+        const std::vector<char>& data;
+        std::size_t pos;
+
+        bool bytes(void* out, std::size_t size) {
+            if (data.size() - pos < size) {
+                return false;
+            }
+            std::memcpy(out, data.data() + pos, size);
+            pos += size;
+            return true;
+        }
+
+        template <typename T>
+        bool raw(T& value) {
+            return bytes(&value, sizeof(T));
+        }
+
+        bool varint(std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte = 0;
+                if (!raw(byte)) {
+                    return false;
+                }
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    template <typename T>
+    static void writeRaw(std::vector<char>& out, const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void writeVarint(std::vector<char>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    std::uint64_t frames = 0;
+};
+
+// Lee los frames de una grabación en orden y comprueba los checkpoints
+class InputReplay {
+public:
+    explicit InputReplay(const InputRecording& recording) : recording(recording) {}
+
+    bool done() const { return run >= recording.runs.size(); }
+
+    std::uint8_t next() {
+        const InputRun& current = recording.runs[run];
+        std::uint8_t frame = current.frame;
+        if (++offset == current.length) {
+            ++run;
+            offset = 0;
+        }
+        ++frames;
+        return frame;
+    }
+
+    // Llamar tras aplicar cada frame: compara el hash si toca checkpoint
+    template <typename World>
+    void verify(const World& world) {
+        while (checkpoint < recording.checkpoints.size() && recording.checkpoints[checkpoint].frames < frames) {
+            ++checkpoint;
+        }
+        if (checkpoint < recording.checkpoints.size() && recording.checkpoints[checkpoint].frames == frames) {
+            if (hashWorldState(world) == recording.checkpoints[checkpoint].hash) {
+                ++matched;
+            } else {
+                if (mismatched == 0) {
+                    firstMismatch = frames;
+                }
+                ++mismatched;
+            }
+            ++checkpoint;
+        }
+    }
+
+    std::uint64_t framesPlayed() const { return frames; }
+    std::uint64_t checkpointsMatched() const { return matched; }
+    std::uint64_t checkpointsMismatched() const { return mismatched; }
+    std::uint64_t firstMismatchFrame() const { return firstMismatch; }
+
+private:
+    const InputRecording& recording;
+    std::size_t run = 0;
+    std::uint32_t offset = 0;
+    std::uint64_t frames = 0;
+    std::size_t checkpoint = 0;
+    std::uint64_t matched = 0;
+    std::uint64_t mismatched = 0;
+    std::uint64_t firstMismatch = 0;
+};
+
+// Graba frames y, cada RECORDING_CHECKPOINT_INTERVAL, el hash del estado
+class InputRecorder {
+public:
+    explicit InputRecorder(InputRecording& recording) : recording(recording) {}
+
+    // Llamar tras aplicar cada frame
+    template <typename World>
+    void record(std::uint8_t frame, const World& world) {
+        recording.append(frame);
+        if (recording.frameCount() % RECORDING_CHECKPOINT_INTERVAL == 0) {
+            recording.addCheckpoint(hashWorldState(world));
+        }
+    }
+
+private:
+    InputRecording& recording;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos con robo de trabajo para repartir trozos (chunks) de un tick.
+// Cada hilo tiene su propia cola: saca trabajo del final de la suya y, cuando
+// se queda sin nada, roba del principio de las colas de los demás. El hilo
+// que llama a parallelFor también trabaja (es el hilo 0) y espera a que
+// terminen todos los trozos antes de volver.
+//
+// parallelFor no es reentrante: solo debe llamarlo un hilo a la vez.
+class JobSystem {
+public:
+    explicit JobSystem(unsigned threadCount = std::thread::hardware_concurrency())
+        : threadCount(std::max(1u, threadCount)), queues(this->threadCount) {
+        for (unsigned i = 1; i < this->threadCount; ++i) {
+            threads.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Número de hilos que ejecutan trabajo (incluido el llamador)
+    unsigned size() const { return threadCount; }
+
+    // Ejecuta fn(chunk, worker) para chunk en [0, chunks). Los trozos se
+    // reparten en bloques contiguos entre las colas y se equilibran robando.
+    template <typename Fn>
+    void parallelFor(size_t chunks, Fn&& fn) {
+        if (chunks == 0) {
+            return;
+        }
+        if (threadCount == 1 || chunks == 1) {
+            for (size_t c = 0; c < chunks; ++c) {
+                fn(c, 0u);
+            }
+            return;
+        }
+
+        using Callable = typename std::remove_reference<Fn>::type;
+        context = &fn;
+        invoke = [](void* ctx, size_t chunk, unsigned worker) {
+            (*static_cast<Callable*>(ctx))(chunk, worker);
+        };
+        pending.store(chunks, std::memory_order_relaxed);
+
+        for (unsigned q = 0; q < threadCount; ++q) {
+            size_t begin = chunks * q / threadCount;
+            size_t end = chunks * (q + 1) / threadCount;
+            std::lock_guard<std::mutex> lock(queues[q].mutex);
+            for (size_t c = begin; c < end; ++c) {
+                queues[q].items.push_back(c);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            ++generation;
+        }
+        wake.notify_all();
+
+        runTasks(0);
+        while (pending.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    // Cola de un hilo: el dueño saca por el final y los ladrones por 'head'
+    struct Queue {
+        std::mutex mutex;
+        std::vector<size_t> items;
+        size_t head = 0;
+    };
+
+    bool popLocal(unsigned worker, size_t& chunk) {
+        Queue& q = queues[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.items.size() <= q.head) {
+            return false;
+        }
+        chunk = q.items.back();
+        q.items.pop_back();
+        resetIfEmpty(q);
+        return true;
+    }
+
+    bool steal(unsigned worker, size_t& chunk) {
+        for (unsigned i = 1; i < threadCount; ++i) {
+            Queue& q = queues[(worker + i) % threadCount];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.items.size() > q.head) {
+                chunk = q.items[q.head++];
+                resetIfEmpty(q);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void resetIfEmpty(Queue& q) {
+        if (q.items.size() <= q.head) {
+            q.items.clear();
+            q.head = 0;
+        }
+    }
+
+    void runTasks(unsigned worker) {
+        size_t chunk;
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (!popLocal(worker, chunk) && !steal(worker, chunk)) {
+                return;
+            }
+            invoke(context, chunk, worker);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void workerLoop(unsigned worker) {
+        unsigned seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            runTasks(worker);
+        }
+    }
+
+    unsigned threadCount;
+    std::vector<Queue> queues;
+    std::vector<std::thread> threads;
+
+    void* context = nullptr;
+    void (*invoke)(void*, size_t, unsigned) = nullptr;
+    std::atomic<size_t> pending{ 0 };
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    unsigned generation = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Arena lineal: un bloque de memoria reservado una vez del que se sacan
+// trozos en orden, solo avanzando un desplazamiento. No hay liberación por
+// trozo: reset() vuelve a una marca y todo lo sacado después queda libre de
+// golpe.
+//
+// Solo guarda tipos trivialmente copiables y sin punteros entre trozos, así
+// que el contenido entero se puede copiar con memcpy (save/restore). Quien
+// reparte la arena en trozos siempre en el mismo orden y con los mismos
+// tamaños obtiene las mismas direcciones, y una foto sirve para cualquier
+// arena repartida igual.
+
+// Cada trozo empieza en su propia línea de caché
+constexpr std::size_t ARENA_ALIGN = 64;
+
+// Contenido de una arena (los bytes usados) para restaurarlo después
+using ArenaSnapshot = std::vector<unsigned char>;
+
+class LinearArena {
+public:
+    // Bytes que ocupan n elementos de T, redondeados al alineamiento de los trozos
+    template <typename T>
+    static constexpr std::size_t bytesFor(std::size_t n) {
+        return (n * sizeof(T) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    }
+
+    // Toda la memoria se reserva aquí, a cero
+    explicit LinearArena(std::size_t capacity = 0)
+        : buffer(new unsigned char[capacity + ARENA_ALIGN]()), capacityBytes(capacity) {
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(buffer.get()) % ARENA_ALIGN;
+        base = buffer.get() + (misalignment ? ARENA_ALIGN - misalignment : 0);
+    }
+
+    // Trozo para n elementos de T, sin construir: conserva lo que hubiera en
+    // esa memoria (a cero la primera vez). Sin sitio es un error de cálculo
+    // del que reparte la arena, así que se lanza std::bad_alloc.
+    template <typename T>
+    T* allocate(std::size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "la arena se copia con memcpy");
+        static_assert(alignof(T) <= ARENA_ALIGN, "alineamiento mayor que el de la arena");
+        std::size_t bytes = bytesFor<T>(n);
+        if (bytes > capacityBytes - offset) {
+            throw std::bad_alloc();
+        }
+        T* chunk = reinterpret_cast<T*>(base + offset);
+        offset += bytes;
+        return chunk;
+    }
+
+    // Trozo para un T construido con 'args'
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate<T>(1)) T(std::forward<Args>(args)...);
+    }
+
+    // Marca para volver luego con reset()
+    std::size_t mark() const { return offset; }
+
+    // Libera de golpe todo lo sacado desde 'to'
+    void reset(std::size_t to = 0) {
+        offset = to;
+    }
+
+    std::size_t used() const { return offset; }
+    std::size_t capacity() const { return capacityBytes; }
+
+    // Copia los bytes usados en 'out' (sin reservar si ya tenía sitio)
+    void save(ArenaSnapshot& out) const {
+        out.assign(base, base + offset);
+    }
+
+    // Vuelve al contenido de una foto. Solo vale una foto de esta arena o de
+    // otra repartida igual: si no ocupa lo mismo, no se toca nada.
+    bool restore(const ArenaSnapshot& in) {
+        if (in.size() != offset) {
+            return false;
+        }
+        std::memcpy(base, in.data(), offset);
+        return true;
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    unsigned char* base;
+    std::size_t capacityBytes;
+    std::size_t offset = 0;
+};
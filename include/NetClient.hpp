@@ -0,0 +1,378 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.hpp"
+#include "NetProtocol.hpp"
+#include "NetSocket.hpp"
+#include "Simulation.hpp"
+
+// Cliente del multijugador, sin ventana: manda una entrada por tick, recibe
+// las fotos del servidor y prepara lo que hay que dibujar.
+//  - La nave propia se predice: se parte de la última nave que ha mandado
+//    el servidor y se vuelven a aplicar con advancePlayer las entradas que
+//    aún no había simulado. El salto de cada corrección se reparte en
+//    varios frames.
+//  - Todo lo demás se interpola entre dos fotos recibidas, dibujando
+//    NET_INTERPOLATION_DELAY por detrás del servidor.
+
+constexpr double NET_INTERPOLATION_DELAY = 0.1;  // Dos fotos a 20 Hz
+constexpr double NET_HELLO_INTERVAL = 0.5;
+constexpr std::uint32_t NET_INPUT_HISTORY = 128;
+// Parte del error de predicción que se corrige en cada frame
+constexpr float NET_CORRECTION_RATE = 0.2f;
+
+// Lo que hay que dibujar en un instante
+struct NetView {
+    struct Ship {
+        sf::Vector2f position;
+        BinaryAngle angle = 0;
+        int slot = 0;
+        int score = 0;
+        bool own = false;
+    };
+    std::vector<Ship> ships;
+    std::vector<sf::Vector2f> asteroids;
+    std::vector<BinaryAngle> asteroidAngles;
+    std::vector<sf::Vector2f> bullets;
+    int score = 0;  // De la nave propia
+};
+
+struct NetClientStats {
+    std::uint64_t snapshots = 0;
+    std::uint64_t snapshotBytes = 0;
+    std::uint64_t lostSnapshots = 0;       // Huecos en los ticks de las fotos recibidas
+    std::uint64_t undecodable = 0;         // Fotos cuya baseline ya no estaba
+    std::uint64_t predictionSamples = 0;
+    double predictionErrorSum = 0.0;       // Píxeles entre la predicción y el servidor
+    float predictionErrorMax = 0.0f;
+    std::uint64_t interpolatedFrames = 0;
+    std::uint64_t extrapolatedFrames = 0;  // Sin foto posterior al instante de dibujo
+};
+
+class NetClient {
+public:
+    NetClient(const sf::IpAddress& server, unsigned short port = NET_DEFAULT_PORT,
+              const NetConditions& conditions = NetConditions(), std::uint32_t seed = 1)
+        : server(server), serverPort(port), socket(conditions, seed), start(Clock::now()) {}
+
+    bool connect() {
+        return socket.bind(sf::Socket::AnyPort);
+    }
+
+    void disconnect() {
+        BitWriter writer(packet.data(), packet.size());
+        writePacketHeader(writer, NetMessage::Bye);
+        socket.send(packet.data(), writer.bytes(), server, serverPort);
+        socket.update();
+    }
+
+    // Un tick local (NET_TICK_DT): recibe, predice la nave propia con la
+    // entrada del tick y se la manda al servidor
+    void update(std::uint8_t input) {
+        double now = seconds();
+        receivePackets(now);
+        if (ship < 0) {
+            if (now - lastHello >= NET_HELLO_INTERVAL) {
+                lastHello = now;
+                BitWriter writer(packet.data(), packet.size());
+                writePacketHeader(writer, NetMessage::Hello);
+                socket.send(packet.data(), writer.bytes(), server, serverPort);
+            }
+            socket.update();
+            return;
+        }
+
+        ++inputSeq;
+        inputHistory[inputSeq % NET_INPUT_HISTORY] = input;
+        if (predictedAlive) {
+            advancePlayer(predicted, input, NET_TICK_DT, scratchSpawns, scratchEvents);
+            scratchSpawns.clear();
+        }
+        predictedHistory[inputSeq % NET_INPUT_HISTORY] = predicted.position;
+        sendInput();
+        socket.update();
+    }
+
+    bool connected() const { return ship >= 0; }
+    bool full() const { return serverFull; }
+    int shipSlot() const { return ship; }
+    std::uint32_t latestTick() const { return latest ? latest->tick : 0; }
+    const NetSocketStats& transport() const { return socket.stats; }
+
+    // Estado para dibujar ahora: la nave propia predicha y el resto
+    // interpolado entre las dos fotos que rodean el instante de dibujo
+    void view(NetView& out) {
+        out.ships.clear();
+        out.asteroids.clear();
+        out.asteroidAngles.clear();
+        out.bullets.clear();
+        out.score = 0;
+        if (!latest) {
+            return;
+        }
+
+        double renderTick = (seconds() + clockOffset - NET_INTERPOLATION_DELAY) / NET_TICK_DT;
+        const NetWorldState* from = nullptr;
+        const NetWorldState* to = nullptr;
+        for (const NetWorldState& state : received) {
+            if (state.tick == 0) {
+                continue;
+            }
+            if (state.tick <= renderTick && (!from || state.tick > from->tick)) {
+                from = &state;
+            }
+            if (state.tick > renderTick && (!to || state.tick < to->tick)) {
+                to = &state;
+            }
+        }
+        if (!from) {
+            from = to;
+        }
+        if (!to) {
+            to = from;
+            stats.extrapolatedFrames++;
+        } else {
+            stats.interpolatedFrames++;
+        }
+        float t = to->tick > from->tick
+            ? static_cast<float>((renderTick - from->tick) / (to->tick - from->tick)) : 0.0f;
+        t = std::min(std::max(t, 0.0f), 1.0f);
+
+        interpolateBodies(from->asteroids, to->asteroids, t, [&out](const sf::Vector2f& position, BinaryAngle angle) {
+            out.asteroids.push_back(position);
+            out.asteroidAngles.push_back(angle);
+        });
+        interpolateBodies(from->bullets, to->bullets, t, [&out](const sf::Vector2f& position, BinaryAngle) {
+            out.bullets.push_back(position);
+        });
+
+        for (const NetShip& s : latest->ships) {
+            if (s.slot == ship) {
+                out.score = s.score;
+                if (predictedAlive) {
+                    correction *= 1.0f - NET_CORRECTION_RATE;
+                    out.ships.push_back({ predicted.position + correction, predicted.angle, s.slot, s.score, true });
+                }
+            }
+        }
+        for (const NetShip& a : from->ships) {
+            if (a.slot == ship || !a.alive) {
+                continue;
+            }
+            NetView::Ship drawn{ a.position(), a.binaryAngle(), a.slot, a.score, false };
+            for (const NetShip& b : to->ships) {
+                if (b.slot == a.slot && b.alive) {
+                    drawn.position = a.position() + (b.position() - a.position()) * t;
+                    drawn.angle = lerpAngle(a.binaryAngle(), b.binaryAngle(), t);
+                    drawn.score = b.score;
+                }
+            }
+            out.ships.push_back(drawn);
+        }
+    }
+
+    NetClientStats stats;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double seconds() const {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Los cuerpos de las dos fotos van ordenados por slot: se recorren a la
+    // vez y se interpolan los que son el mismo (slot y generación). Los que
+    // solo están en la primera se dibujan quietos en su sitio.
+    template <typename Emit>
+    static void interpolateBodies(const std::vector<NetBody>& from, const std::vector<NetBody>& to, float t, Emit&& emit) {
+        size_t j = 0;
+        for (const NetBody& a : from) {
+            while (j < to.size() && to[j].slot < a.slot) {
+                ++j;
+            }
+            if (j < to.size() && to[j].slot == a.slot && to[j].generation == a.generation) {
+                const NetBody& b = to[j];
+                emit(a.position() + (b.position() - a.position()) * t, lerpAngle(a.binaryAngle(), b.binaryAngle(), t));
+            } else {
+                emit(a.position(), a.binaryAngle());
+            }
+        }
+    }
+
+    void receivePackets(double now) {
+        sf::IpAddress address;
+        unsigned short port = 0;
+        size_t size = 0;
+        while (socket.receive(packet.data(), packet.size(), size, address, port)) {
+            if (address != server || port != serverPort) {
+                continue;
+            }
+            BitReader reader(packet.data(), size);
+            NetMessage type;
+            if (!readPacketHeader(reader, type)) {
+                continue;
+            }
+            if (type == NetMessage::Welcome && ship < 0) {
+                ship = static_cast<int>(reader.read(NET_SHIP_BITS));
+                serverFull = false;
+            } else if (type == NetMessage::Full) {
+                serverFull = true;
+            } else if (type == NetMessage::Snapshot) {
+                readSnapshot(reader, size, now);
+            }
+        }
+    }
+
+    void readSnapshot(BitReader& reader, size_t size, double now) {
+        NetSnapshotHeader header;
+        if (!readSnapshotHeader(reader, header) || header.ship < 0) {
+            return;
+        }
+        // Si se perdió el Welcome, la foto también dice cuál es la nave
+        ship = header.ship;
+        const NetWorldState* baseline = &empty;
+        if (header.baselineTick != 0) {
+            baseline = nullptr;
+            for (const NetWorldState& state : received) {
+                if (state.tick == header.baselineTick) {
+                    baseline = &state;
+                }
+            }
+            if (!baseline) {
+                stats.undecodable++;
+                return;
+            }
+        }
+        // Se decodifica en el hueco de la foto más antigua (nunca la baseline)
+        NetWorldState* slot = &received[0];
+        for (NetWorldState& state : received) {
+            if (&state != baseline && (state.tick < slot->tick || slot == baseline)) {
+                slot = &state;
+            }
+        }
+        if (!decodeSnapshot(reader, header, *baseline, *slot)) {
+            slot->clear();
+            return;
+        }
+        stats.snapshots++;
+        stats.snapshotBytes += size;
+
+        // Reloj del servidor: la muestra más adelantada es la que menos se
+        // ha retrasado por el camino; si todas llegan tarde, se deriva poco a poco
+        double offset = slot->tick * static_cast<double>(NET_TICK_DT) - now;
+        if (!clockSynced || offset > clockOffset) {
+            clockOffset = offset;
+            clockSynced = true;
+        } else {
+            clockOffset += (offset - clockOffset) * 0.01;
+        }
+
+        if (!latest || slot->tick > latest->tick) {
+            if (latest && slot->tick - latest->tick > snapshotSpacing && snapshotSpacing > 0) {
+                stats.lostSnapshots += (slot->tick - latest->tick) / snapshotSpacing - 1;
+            }
+            if (latest) {
+                snapshotSpacing = snapshotSpacing ? std::min(snapshotSpacing, slot->tick - latest->tick)
+                                                  : slot->tick - latest->tick;
+            }
+            latest = slot;
+            reconcile(header.lastProcessedInput);
+        }
+    }
+
+    // Nave del servidor + entradas que aún no ha simulado
+    void reconcile(std::uint32_t lastProcessed) {
+        const NetShip* own = nullptr;
+        for (const NetShip& s : latest->ships) {
+            if (s.slot == ship) {
+                own = &s;
+            }
+        }
+        if (!own || !own->alive) {
+            predictedAlive = false;
+            return;
+        }
+        PlayerState authoritative;
+        authoritative.position = own->position();
+        authoritative.angle = own->binaryAngle();
+
+        // Error de la predicción que se hizo para esa misma entrada
+        bool comparable = predictedAlive && lastProcessed > 0 && inputSeq >= lastProcessed
+                       && inputSeq - lastProcessed < NET_INPUT_HISTORY;
+        if (comparable) {
+            sf::Vector2f error = predictedHistory[lastProcessed % NET_INPUT_HISTORY] - authoritative.position;
+            float distance = std::sqrt(error.x * error.x + error.y * error.y);
+            stats.predictionSamples++;
+            stats.predictionErrorSum += distance;
+            stats.predictionErrorMax = std::max(stats.predictionErrorMax, distance);
+        }
+
+        sf::Vector2f before = predicted.position + correction;
+        predicted.position = authoritative.position;
+        predicted.angle = authoritative.angle;
+        std::uint32_t first = lastProcessed + 1;
+        if (inputSeq >= NET_INPUT_HISTORY && first < inputSeq - NET_INPUT_HISTORY + 1) {
+            first = inputSeq - NET_INPUT_HISTORY + 1;
+        }
+        for (std::uint32_t seq = first; seq <= inputSeq; seq++) {
+            advancePlayer(predicted, inputHistory[seq % NET_INPUT_HISTORY], NET_TICK_DT, scratchSpawns, scratchEvents);
+            predictedHistory[seq % NET_INPUT_HISTORY] = predicted.position;
+        }
+        scratchSpawns.clear();
+        if (predictedAlive) {
+            correction = before - predicted.position;
+        } else {
+            correction = sf::Vector2f();
+        }
+        predictedAlive = true;
+    }
+
+    void sendInput() {
+        BitWriter writer(packet.data(), packet.size());
+        writePacketHeader(writer, NetMessage::Input);
+        writer.write(latest ? latest->tick : 0, 32);
+        writer.write(inputSeq, 32);
+        std::uint32_t count = std::min<std::uint32_t>(NET_INPUT_REDUNDANCY, inputSeq);
+        writer.write(count, 4);
+        for (std::uint32_t k = 0; k < count; k++) {
+            writer.write(inputHistory[(inputSeq - k) % NET_INPUT_HISTORY], 4);
+        }
+        socket.send(packet.data(), writer.bytes(), server, serverPort);
+    }
+
+    sf::IpAddress server;
+    unsigned short serverPort;
+    NetSocket socket;
+    Clock::time_point start;
+    std::array<std::uint8_t, NET_MAX_PACKET> packet{};
+
+    int ship = -1;
+    bool serverFull = false;
+    double lastHello = -NET_HELLO_INTERVAL;
+
+    // Fotos recibidas (baselines y pares para interpolar)
+    std::array<NetWorldState, NET_SNAPSHOT_HISTORY> received;
+    const NetWorldState* latest = nullptr;
+    NetWorldState empty;
+    std::uint32_t snapshotSpacing = 0;
+    double clockOffset = 0.0;
+    bool clockSynced = false;
+
+    // Predicción de la nave propia
+    std::uint32_t inputSeq = 0;
+    std::array<std::uint8_t, NET_INPUT_HISTORY> inputHistory{};
+    std::array<sf::Vector2f, NET_INPUT_HISTORY> predictedHistory{};
+    PlayerState predicted;
+    bool predictedAlive = false;
+    sf::Vector2f correction;
+    std::vector<BulletSpawn> scratchSpawns;
+    TickEvents scratchEvents;
+};
@@ -0,0 +1,615 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.hpp"
+#include "ArenaSimulation.hpp"
+#include "Simulation.hpp"
+
+// Protocolo del multijugador sobre UDP. El servidor es la autoridad: recibe
+// las entradas de cada cliente y manda fotos del mundo cuantizadas y
+// comprimidas contra la última foto que el cliente ha confirmado (baseline).
+//
+// Compresión de una foto contra su baseline:
+//  - Posiciones en 1/4 de píxel y direcciones en 1/4096, en enteros.
+//  - Asteroides y balas de la baseline: el receptor predice dónde están
+//    ahora con aritmética entera (idéntica en los dos lados), así que para
+//    la mayoría basta un bit de "sigue vivo" y otro de "sin cambios". Si la
+//    predicción se aleja más de NET_POSITION_TOLERANCE, va la corrección.
+//  - Lo que no está en la baseline va completo; si no cabe en el paquete,
+//    se queda para la foto siguiente (el cliente sabe exactamente qué tiene).
+//  - Las naves van siempre completas.
+// Las bajas son el bit de "sigue vivo" a 0; las altas, los registros nuevos.
+
+constexpr std::uint16_t NET_PROTOCOL_ID = 0x5348;  // "SH"
+constexpr unsigned short NET_DEFAULT_PORT = 54321;
+
+// Tamaño máximo de un paquete: cabe en un MTU de 1500 con las cabeceras IP y
+// UDP y margen para túneles y VPN
+constexpr size_t NET_MAX_PACKET = 1200;
+
+// El servidor simula a 60 Hz; las predicciones cuentan en ticks
+constexpr float NET_TICK_DT = SIM_DT;
+
+// Fotos que recuerda cada lado para usarlas como baseline
+constexpr std::uint32_t NET_SNAPSHOT_HISTORY = 32;
+
+// Entradas que repite cada paquete del cliente (por si se pierden paquetes)
+constexpr int NET_INPUT_REDUNDANCY = 8;
+
+enum class NetMessage : std::uint8_t {
+    Hello = 1,     // Cliente -> servidor: quiero jugar
+    Welcome = 2,   // Servidor -> cliente: nave asignada
+    Full = 3,      // Servidor -> cliente: no quedan naves
+    Input = 4,     // Cliente -> servidor: últimas entradas + foto confirmada
+    Snapshot = 5,  // Servidor -> cliente: foto del mundo
+    Bye = 6        // Cualquiera: fin de la conexión
+};
+
+// Escritura de bits sobre un buffer fijo. Si no cabe, marca el desbordamiento
+// y deja de escribir.
+class BitWriter {
+public:
+    BitWriter(std::uint8_t* data, size_t capacity) : data(data), capacityBits(capacity * 8) {
+        std::fill(data, data + capacity, 0);
+    }
+
+    void write(std::uint32_t value, int bits) {
+        if (bitCount + bits > capacityBits) {
+            overflow = true;
+            bitCount = capacityBits;
+            return;
+        }
+        for (int i = bits - 1; i >= 0; --i) {
+            if ((value >> i) & 1u) {
+                data[bitCount >> 3] |= static_cast<std::uint8_t>(0x80u >> (bitCount & 7));
+            }
+            ++bitCount;
+        }
+    }
+
+    void writeBool(bool value) { write(value ? 1u : 0u, 1); }
+
+    // Exp-Golomb de orden 0: 1 bit para el 0, 3 para 1-2, 5 para 3-6...
+    void writeUnsigned(std::uint32_t value) {
+        std::uint64_t n = static_cast<std::uint64_t>(value) + 1;
+        int length = 0;
+        while ((n >> (length + 1)) != 0) {
+            ++length;
+        }
+        write(0, length);
+        write(static_cast<std::uint32_t>(n >> 32), length >= 32 ? 1 : 0);
+        write(static_cast<std::uint32_t>(n), std::min(length + 1, 32));
+    }
+
+    // Zigzag (0, -1, 1, -2...) y Exp-Golomb
+    void writeSigned(std::int32_t value) {
+        std::uint32_t zigzag = (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+        writeUnsigned(zigzag);
+    }
+
+    static int unsignedBits(std::uint32_t value) {
+        std::uint64_t n = static_cast<std::uint64_t>(value) + 1;
+        int length = 0;
+        while ((n >> (length + 1)) != 0) {
+            ++length;
+        }
+        return 2 * length + 1;
+    }
+
+    size_t bitsUsed() const { return bitCount; }
+    size_t bitsLeft() const { return capacityBits - bitCount; }
+    size_t bytes() const { return (bitCount + 7) / 8; }
+    bool overflowed() const { return overflow; }
+
+private:
+    std::uint8_t* data;
+    size_t capacityBits;
+    size_t bitCount = 0;
+    bool overflow = false;
+};
+
+// Lectura de bits. Leer más allá del final devuelve ceros y marca el error.
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, size_t size) : data(data), sizeBits(size * 8) {}
+
+    std::uint32_t read(int bits) {
+        if (bitCount + bits > sizeBits) {
+            error = true;
+            bitCount = sizeBits;
+            return 0;
+        }
+        std::uint32_t value = 0;
+        for (int i = 0; i < bits; ++i) {
+            value = (value << 1) | ((data[bitCount >> 3] >> (7 - (bitCount & 7))) & 1u);
+            ++bitCount;
+        }
+        return value;
+    }
+
+    bool readBool() { return read(1) != 0; }
+
+    std::uint32_t readUnsigned() {
+        int length = 0;
+        while (!error && read(1) == 0) {
+            if (++length > 32) {
+                error = true;
+                return 0;
+            }
+        }
+        // El 1 ya leído es el bit alto de n = valor + 1
+        std::uint64_t n = 1;
+        for (int i = 0; i < length; ++i) {
+            n = (n << 1) | read(1);
+        }
+        return static_cast<std::uint32_t>(n - 1);
+    }
+
+    std::int32_t readSigned() {
+        std::uint32_t zigzag = readUnsigned();
+        return static_cast<std::int32_t>(zigzag >> 1) ^ -static_cast<std::int32_t>(zigzag & 1);
+    }
+
+    bool failed() const { return error; }
+
+private:
+    const std::uint8_t* data;
+    size_t sizeBits;
+    size_t bitCount = 0;
+    bool error = false;
+};
+
+// Cuantización
+constexpr int NET_POSITION_SCALE = 4;        // 1/4 de píxel
+constexpr int NET_X_BITS = 13;               // 0..2047 px
+constexpr int NET_Y_BITS = 12;               // 0..1023 px
+constexpr int NET_DIRECTION_SCALE = 4096;    // Componentes de dirección en 1/4096
+constexpr int NET_DIRECTION_BITS = 14;       // -4096..4096 con sesgo
+constexpr int NET_SHIP_ANGLE_BITS = 12;      // 4096 pasos por vuelta
+constexpr int NET_ASTEROID_ANGLE_BITS = 8;   // Se envía solo al aparecer o corregir
+constexpr int NET_GENERATION_BITS = 6;
+constexpr int NET_SHIP_BITS = 3;             // ARENA_MAX_SHIPS = 8
+constexpr int NET_POSITION_TOLERANCE = 2;    // Error de predicción admitido (1/2 px)
+constexpr int NET_ANGLE_TOLERANCE = 1 << 9;  // En 1/65536 de vuelta (~3 grados)
+
+// Desplazamiento por tick en 1/256 de unidad de posición
+constexpr std::int32_t netTickStep(float speed) {
+    return static_cast<std::int32_t>(speed * NET_TICK_DT * NET_POSITION_SCALE * 256.0f + 0.5f);
+}
+
+// Ángulo binario redondeado a sus 'bits' bits altos
+constexpr std::uint32_t netAngle(BinaryAngle angle, int bits) {
+    return static_cast<BinaryAngle>(angle + (1u << (31 - bits))) >> (32 - bits);
+}
+
+// Giro de los asteroides por tick en 1/65536 de vuelta
+constexpr std::uint16_t NET_ASTEROID_SPIN_STEP =
+    static_cast<std::uint16_t>(netAngle(angleFromDegrees(ASTEROID_SPIN * NET_TICK_DT), 16));
+
+// Asteroide o bala cuantizada. 'slot' y 'generation' vienen del handle del
+// pool, así que identifican la entidad entre fotos.
+struct NetBody {
+    std::uint16_t slot = 0;
+    std::uint8_t generation = 0;
+    std::int32_t x = 0, y = 0;     // 1/4 de píxel
+    std::int16_t dx = 0, dy = 0;   // 1/4096
+    std::uint16_t angle = 0;       // 1/65536 de vuelta (asteroides)
+    std::uint8_t owner = 0;        // Nave que disparó (balas)
+
+    sf::Vector2f position() const {
+        return { static_cast<float>(x) / NET_POSITION_SCALE, static_cast<float>(y) / NET_POSITION_SCALE };
+    }
+    BinaryAngle binaryAngle() const { return static_cast<BinaryAngle>(angle) << 16; }
+};
+
+struct NetShip {
+    std::uint8_t slot = 0;
+    bool alive = false;
+    std::int32_t x = 0, y = 0;
+    std::uint16_t angle = 0;  // 1/4096 de vuelta
+    std::int32_t score = 0;
+
+    sf::Vector2f position() const {
+        return { static_cast<float>(x) / NET_POSITION_SCALE, static_cast<float>(y) / NET_POSITION_SCALE };
+    }
+    BinaryAngle binaryAngle() const { return static_cast<BinaryAngle>(angle) << (32 - NET_SHIP_ANGLE_BITS); }
+};
+
+// Qué sabe cada tipo de cuerpo sobre sí mismo para codificarse y predecirse
+struct NetBodyKind {
+    int slotBits;
+    std::int32_t tickStep;
+    bool bounces;
+    bool hasAngle;
+    bool hasOwner;
+};
+
+constexpr NetBodyKind NET_ASTEROIDS = { 12, netTickStep(ASTEROID_SPEED), true, true, false };
+constexpr NetBodyKind NET_BULLETS = { 10, netTickStep(BULLET_SPEED), false, false, true };
+
+// Mundo cuantizado en un tick: lo que el servidor quiere enviar, o lo que
+// el cliente ha reconstruido. Cuerpos ordenados por slot.
+struct NetWorldState {
+    std::uint32_t tick = 0;  // 0: vacío (sin baseline)
+    std::vector<NetShip> ships;
+    std::vector<NetBody> asteroids;
+    std::vector<NetBody> bullets;
+
+    void clear() {
+        tick = 0;
+        ships.clear();
+        asteroids.clear();
+        bullets.clear();
+    }
+};
+
+inline std::int32_t netQuantize(float value, int scale) {
+    return static_cast<std::int32_t>(std::lround(value * scale));
+}
+
+inline std::int32_t netClampBits(std::int32_t value, int bits) {
+    return std::min(std::max(value, 0), (1 << bits) - 1);
+}
+
+// Cuantiza el mundo del servidor. Las balas fuera de la pantalla no se ven
+// y no se envían.
+inline void buildNetWorldState(const ArenaSimulation& world, NetWorldState& out) {
+    out.clear();
+    out.tick = static_cast<std::uint32_t>(world.tick);
+    for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+        const ArenaShip& ship = world.ships[i];
+        if (!ship.joined) {
+            continue;
+        }
+        NetShip net;
+        net.slot = static_cast<std::uint8_t>(i);
+        net.alive = ship.alive;
+        net.x = netClampBits(netQuantize(ship.state.position.x, NET_POSITION_SCALE), NET_X_BITS);
+        net.y = netClampBits(netQuantize(ship.state.position.y, NET_POSITION_SCALE), NET_Y_BITS);
+        net.angle = static_cast<std::uint16_t>(netAngle(ship.state.angle, NET_SHIP_ANGLE_BITS));
+        net.score = ship.score;
+        out.ships.push_back(net);
+    }
+
+    auto body = [](EntityHandle handle, float x, float y, float dx, float dy) {
+        NetBody net;
+        net.slot = static_cast<std::uint16_t>(handle.slot);
+        net.generation = static_cast<std::uint8_t>(handle.generation & ((1u << NET_GENERATION_BITS) - 1));
+        net.x = netClampBits(netQuantize(x, NET_POSITION_SCALE), NET_X_BITS);
+        net.y = netClampBits(netQuantize(y, NET_POSITION_SCALE), NET_Y_BITS);
+        net.dx = static_cast<std::int16_t>(netQuantize(dx, NET_DIRECTION_SCALE));
+        net.dy = static_cast<std::int16_t>(netQuantize(dy, NET_DIRECTION_SCALE));
+        return net;
+    };
+    const AsteroidArrays& a = world.asteroids.arrays;
+    for (size_t i = 0; i < a.size(); i++) {
+        NetBody net = body(world.asteroids.handleAt(i), a.x[i], a.y[i], a.dx[i], a.dy[i]);
+        net.angle = static_cast<std::uint16_t>(netAngle(a.angle[i], 16));
+        out.asteroids.push_back(net);
+    }
+    const OwnedBulletArrays& b = world.bullets.arrays;
+    for (size_t i = 0; i < b.size(); i++) {
+        if (b.x[i] < 0.0f || b.x[i] > SCREEN_WIDTH || b.y[i] < 0.0f || b.y[i] > SCREEN_HEIGHT) {
+            continue;
+        }
+        NetBody net = body(world.bullets.handleAt(i), b.x[i], b.y[i], b.dx[i], b.dy[i]);
+        net.owner = b.owner[i];
+        out.bullets.push_back(net);
+    }
+    auto bySlot = [](const NetBody& l, const NetBody& r) { return l.slot < r.slot; };
+    std::sort(out.asteroids.begin(), out.asteroids.end(), bySlot);
+    std::sort(out.bullets.begin(), out.bullets.end(), bySlot);
+}
+
+// Posición de un cuerpo 'ticks' después, solo con enteros: un paso por tick
+// (con rebote en los bordes para los asteroides, como integrateAsteroids)
+inline NetBody netPredict(const NetBody& body, std::uint32_t ticks, const NetBodyKind& kind) {
+    NetBody out = body;
+    auto step = [&kind](std::int32_t direction) {
+        std::int64_t scaled = static_cast<std::int64_t>(direction) * kind.tickStep;
+        return static_cast<std::int32_t>(scaled >= 0 ? (scaled + NET_DIRECTION_SCALE / 2) / NET_DIRECTION_SCALE
+                                                     : -((-scaled + NET_DIRECTION_SCALE / 2) / NET_DIRECTION_SCALE));
+    };
+    std::int64_t x = static_cast<std::int64_t>(body.x) * 256;
+    std::int64_t y = static_cast<std::int64_t>(body.y) * 256;
+    std::int32_t stepX = step(body.dx);
+    std::int32_t stepY = step(body.dy);
+    if (kind.bounces) {
+        const std::int64_t minX = static_cast<std::int64_t>(ASTEROID_BOUNDS.minX * NET_POSITION_SCALE) * 256;
+        const std::int64_t maxX = static_cast<std::int64_t>(ASTEROID_BOUNDS.maxX * NET_POSITION_SCALE) * 256;
+        const std::int64_t minY = static_cast<std::int64_t>(ASTEROID_BOUNDS.minY * NET_POSITION_SCALE) * 256;
+        const std::int64_t maxY = static_cast<std::int64_t>(ASTEROID_BOUNDS.maxY * NET_POSITION_SCALE) * 256;
+        for (std::uint32_t t = 0; t < ticks; ++t) {
+            x += stepX;
+            y += stepY;
+            if (x <= minX || x >= maxX) {
+                stepX = -stepX;
+                out.dx = static_cast<std::int16_t>(-out.dx);
+            }
+            if (y <= minY || y >= maxY) {
+                stepY = -stepY;
+                out.dy = static_cast<std::int16_t>(-out.dy);
+            }
+        }
+        out.angle = static_cast<std::uint16_t>(body.angle + NET_ASTEROID_SPIN_STEP * ticks);
+    } else {
+        x += static_cast<std::int64_t>(stepX) * ticks;
+        y += static_cast<std::int64_t>(stepY) * ticks;
+    }
+    out.x = static_cast<std::int32_t>((x + 128) >> 8);
+    out.y = static_cast<std::int32_t>((y + 128) >> 8);
+    return out;
+}
+
+// Cabecera de una foto
+struct NetSnapshotHeader {
+    std::uint32_t tick = 0;
+    std::uint32_t baselineTick = 0;      // 0: sin baseline
+    std::uint32_t lastProcessedInput = 0;  // Última entrada del cliente ya simulada
+    int ship = -1;                       // Nave del cliente (-1: ninguna)
+};
+
+// Cabecera común de todos los paquetes
+inline void writePacketHeader(BitWriter& writer, NetMessage type) {
+    writer.write(NET_PROTOCOL_ID, 16);
+    writer.write(static_cast<std::uint32_t>(type), 4);
+}
+
+inline bool readPacketHeader(BitReader& reader, NetMessage& type) {
+    if (reader.read(16) != NET_PROTOCOL_ID) {
+        return false;
+    }
+    type = static_cast<NetMessage>(reader.read(4));
+    return !reader.failed();
+}
+
+namespace detail {
+
+inline bool netSameBody(const NetBody& a, const NetBody& b) {
+    return a.slot == b.slot && a.generation == b.generation
+        && std::abs(a.dx) == std::abs(b.dx) && std::abs(a.dy) == std::abs(b.dy);
+}
+
+inline int netBodyBits(const NetBodyKind& kind) {
+    return kind.slotBits + NET_GENERATION_BITS + NET_X_BITS + NET_Y_BITS + 2 * NET_DIRECTION_BITS
+         + (kind.hasAngle ? NET_ASTEROID_ANGLE_BITS : 0) + (kind.hasOwner ? NET_SHIP_BITS : 0);
+}
+
+inline void writeBody(BitWriter& writer, const NetBody& body, const NetBodyKind& kind) {
+    writer.write(body.slot, kind.slotBits);
+    writer.write(body.generation, NET_GENERATION_BITS);
+    writer.write(static_cast<std::uint32_t>(body.x), NET_X_BITS);
+    writer.write(static_cast<std::uint32_t>(body.y), NET_Y_BITS);
+    writer.write(static_cast<std::uint32_t>(body.dx + NET_DIRECTION_SCALE), NET_DIRECTION_BITS);
+    writer.write(static_cast<std::uint32_t>(body.dy + NET_DIRECTION_SCALE), NET_DIRECTION_BITS);
+    if (kind.hasAngle) {
+        writer.write(body.angle >> (16 - NET_ASTEROID_ANGLE_BITS), NET_ASTEROID_ANGLE_BITS);
+    }
+    if (kind.hasOwner) {
+        writer.write(body.owner, NET_SHIP_BITS);
+    }
+}
+
+inline NetBody readBody(BitReader& reader, const NetBodyKind& kind) {
+    NetBody body;
+    body.slot = static_cast<std::uint16_t>(reader.read(kind.slotBits));
+    body.generation = static_cast<std::uint8_t>(reader.read(NET_GENERATION_BITS));
+    body.x = static_cast<std::int32_t>(reader.read(NET_X_BITS));
+    body.y = static_cast<std::int32_t>(reader.read(NET_Y_BITS));
+    body.dx = static_cast<std::int16_t>(static_cast<std::int32_t>(reader.read(NET_DIRECTION_BITS)) - NET_DIRECTION_SCALE);
+    body.dy = static_cast<std::int16_t>(static_cast<std::int32_t>(reader.read(NET_DIRECTION_BITS)) - NET_DIRECTION_SCALE);
+    if (kind.hasAngle) {
+        body.angle = static_cast<std::uint16_t>(reader.read(NET_ASTEROID_ANGLE_BITS) << (16 - NET_ASTEROID_ANGLE_BITS));
+    }
+    if (kind.hasOwner) {
+        body.owner = static_cast<std::uint8_t>(reader.read(NET_SHIP_BITS));
+    }
+    return body;
+}
+
+// Parte de la baseline: por cada cuerpo, vivo/cambiado y, si hace falta, la
+// corrección sobre la predicción. Deja en 'fresh' los cuerpos actuales que
+// no estaban en la baseline.
+inline void writeBaselineBodies(BitWriter& writer, const std::vector<NetBody>& baseline,
+                                const std::vector<NetBody>& current, std::uint32_t ticks,
+                                const NetBodyKind& kind, std::vector<NetBody>& sent,
+                                std::vector<const NetBody*>& fresh) {
+    size_t c = 0;
+    for (const NetBody& base : baseline) {
+        while (c < current.size() && current[c].slot < base.slot) {
+            fresh.push_back(&current[c++]);
+        }
+        if (c >= current.size() || !netSameBody(current[c], base)) {
+            writer.writeBool(false);  // Ya no está (o el slot es de otro cuerpo)
+            continue;
+        }
+        const NetBody& now = current[c++];
+        NetBody predicted = netPredict(base, ticks, kind);
+        std::int32_t errorX = now.x - predicted.x;
+        std::int32_t errorY = now.y - predicted.y;
+        bool flipX = now.dx != predicted.dx;
+        bool flipY = now.dy != predicted.dy;
+        std::int16_t angleError = static_cast<std::int16_t>(now.angle - predicted.angle);
+        bool changed = flipX || flipY || std::abs(errorX) > NET_POSITION_TOLERANCE
+                    || std::abs(errorY) > NET_POSITION_TOLERANCE
+                    || (kind.hasAngle && std::abs(angleError) > NET_ANGLE_TOLERANCE);
+        writer.writeBool(true);
+        writer.writeBool(changed);
+        if (changed) {
+            writer.writeBool(flipX);
+            writer.writeBool(flipY);
+            writer.writeSigned(errorX);
+            writer.writeSigned(errorY);
+            predicted.x = now.x;
+            predicted.y = now.y;
+            predicted.dx = now.dx;
+            predicted.dy = now.dy;
+            if (kind.hasAngle) {
+                writer.write(now.angle >> (16 - NET_ASTEROID_ANGLE_BITS), NET_ASTEROID_ANGLE_BITS);
+                predicted.angle = static_cast<std::uint16_t>((now.angle >> (16 - NET_ASTEROID_ANGLE_BITS))
+                                                             << (16 - NET_ASTEROID_ANGLE_BITS));
+            }
+        }
+        sent.push_back(predicted);
+    }
+    while (c < current.size()) {
+        fresh.push_back(&current[c++]);
+    }
+}
+
+inline bool readBaselineBodies(BitReader& reader, const std::vector<NetBody>& baseline, std::uint32_t ticks,
+                               const NetBodyKind& kind, std::vector<NetBody>& out) {
+    for (const NetBody& base : baseline) {
+        if (!reader.readBool()) {
+            continue;
+        }
+        NetBody body = netPredict(base, ticks, kind);
+        if (reader.readBool()) {
+            if (reader.readBool()) {
+                body.dx = static_cast<std::int16_t>(-body.dx);
+            }
+            if (reader.readBool()) {
+                body.dy = static_cast<std::int16_t>(-body.dy);
+            }
+            body.x += reader.readSigned();
+            body.y += reader.readSigned();
+            if (kind.hasAngle) {
+                body.angle = static_cast<std::uint16_t>(reader.read(NET_ASTEROID_ANGLE_BITS) << (16 - NET_ASTEROID_ANGLE_BITS));
+            }
+        }
+        out.push_back(body);
+    }
+    return !reader.failed();
+}
+
+// Cuerpos nuevos: tantos como quepan en lo que queda del paquete
+inline void writeFreshBodies(BitWriter& writer, const std::vector<const NetBody*>& fresh, const NetBodyKind& kind,
+                             size_t reserveBits, std::vector<NetBody>& sent, size_t& deferred) {
+    const size_t bodyBits = static_cast<size_t>(netBodyBits(kind));
+    const size_t countBits = 2 * 16 + 1;
+    size_t room = writer.bitsLeft() > countBits + reserveBits ? writer.bitsLeft() - countBits - reserveBits : 0;
+    size_t count = std::min(fresh.size(), room / bodyBits);
+    writer.writeUnsigned(static_cast<std::uint32_t>(count));
+    for (size_t i = 0; i < count; i++) {
+        writeBody(writer, *fresh[i], kind);
+        NetBody body = *fresh[i];
+        if (kind.hasAngle) {
+            body.angle = static_cast<std::uint16_t>((body.angle >> (16 - NET_ASTEROID_ANGLE_BITS))
+                                                    << (16 - NET_ASTEROID_ANGLE_BITS));
+        }
+        sent.push_back(body);
+    }
+    deferred += fresh.size() - count;
+}
+
+inline bool readFreshBodies(BitReader& reader, const NetBodyKind& kind, std::vector<NetBody>& out) {
+    std::uint32_t count = reader.readUnsigned();
+    for (std::uint32_t i = 0; i < count && !reader.failed(); i++) {
+        out.push_back(readBody(reader, kind));
+    }
+    return !reader.failed();
+}
+
+inline void sortBodies(std::vector<NetBody>& bodies) {
+    std::sort(bodies.begin(), bodies.end(), [](const NetBody& l, const NetBody& r) { return l.slot < r.slot; });
+}
+
+}  // namespace detail
+
+// Resultado de codificar una foto
+struct NetEncodeResult {
+    size_t bytes = 0;
+    size_t deferred = 0;  // Cuerpos nuevos que no cabían (irán en la siguiente)
+};
+
+// Codifica 'current' contra 'baseline' (tick 0: sin baseline) en 'buffer' y
+// deja en 'sent' exactamente lo que reconstruirá el cliente, que es lo que
+// hay que usar como baseline cuando lo confirme.
+inline NetEncodeResult encodeSnapshot(const NetSnapshotHeader& header, const NetWorldState& baseline,
+                                      const NetWorldState& current, NetWorldState& sent,
+                                      std::uint8_t* buffer, size_t capacity) {
+    using namespace detail;
+    static thread_local std::vector<const NetBody*> freshAsteroids, freshBullets;
+    freshAsteroids.clear();
+    freshBullets.clear();
+    NetEncodeResult result;
+
+    BitWriter writer(buffer, capacity);
+    writePacketHeader(writer, NetMessage::Snapshot);
+    writer.write(header.tick, 32);
+    writer.write(header.baselineTick, 32);
+    writer.write(header.lastProcessedInput, 32);
+    writer.write(static_cast<std::uint32_t>(header.ship + 1), NET_SHIP_BITS + 1);
+
+    sent.clear();
+    sent.tick = current.tick;
+    writer.write(static_cast<std::uint32_t>(current.ships.size()), NET_SHIP_BITS + 1);
+    for (const NetShip& ship : current.ships) {
+        writer.write(ship.slot, NET_SHIP_BITS);
+        writer.writeBool(ship.alive);
+        writer.write(static_cast<std::uint32_t>(ship.x), NET_X_BITS);
+        writer.write(static_cast<std::uint32_t>(ship.y), NET_Y_BITS);
+        writer.write(ship.angle, NET_SHIP_ANGLE_BITS);
+        writer.writeUnsigned(static_cast<std::uint32_t>(std::max(ship.score, 0)));
+        sent.ships.push_back(ship);
+    }
+
+    const std::uint32_t ticks = baseline.tick ? current.tick - baseline.tick : 0;
+    writeBaselineBodies(writer, baseline.asteroids, current.asteroids, ticks, NET_ASTEROIDS, sent.asteroids, freshAsteroids);
+    writeBaselineBodies(writer, baseline.bullets, current.bullets, ticks, NET_BULLETS, sent.bullets, freshBullets);
+    // Balas antes que asteroides: duran poco y se ven enseguida si faltan.
+    // Se guarda sitio para el contador de asteroides nuevos.
+    writeFreshBodies(writer, freshBullets, NET_BULLETS, 2 * 16 + 1, sent.bullets, result.deferred);
+    writeFreshBodies(writer, freshAsteroids, NET_ASTEROIDS, 0, sent.asteroids, result.deferred);
+    sortBodies(sent.asteroids);
+    sortBodies(sent.bullets);
+
+    if (writer.overflowed()) {
+        // Ni siquiera la parte de la baseline cabe: la foto no se envía
+        sent.clear();
+        return NetEncodeResult();
+    }
+    result.bytes = writer.bytes();
+    return result;
+}
+
+// Lee la cabecera de una foto (después de readPacketHeader)
+inline bool readSnapshotHeader(BitReader& reader, NetSnapshotHeader& header) {
+    header.tick = reader.read(32);
+    header.baselineTick = reader.read(32);
+    header.lastProcessedInput = reader.read(32);
+    header.ship = static_cast<int>(reader.read(NET_SHIP_BITS + 1)) - 1;
+    return !reader.failed();
+}
+
+// Reconstruye la foto a partir de su baseline (la que indica la cabecera)
+inline bool decodeSnapshot(BitReader& reader, const NetSnapshotHeader& header, const NetWorldState& baseline,
+                           NetWorldState& out) {
+    using namespace detail;
+    out.clear();
+    out.tick = header.tick;
+    std::uint32_t shipCount = reader.read(NET_SHIP_BITS + 1);
+    for (std::uint32_t i = 0; i < shipCount && !reader.failed(); i++) {
+        NetShip ship;
+        ship.slot = static_cast<std::uint8_t>(reader.read(NET_SHIP_BITS));
+        ship.alive = reader.readBool();
+        ship.x = static_cast<std::int32_t>(reader.read(NET_X_BITS));
+        ship.y = static_cast<std::int32_t>(reader.read(NET_Y_BITS));
+        ship.angle = static_cast<std::uint16_t>(reader.read(NET_SHIP_ANGLE_BITS));
+        ship.score = static_cast<std::int32_t>(reader.readUnsigned());
+        out.ships.push_back(ship);
+    }
+    const std::uint32_t ticks = header.baselineTick ? header.tick - header.baselineTick : 0;
+    bool ok = readBaselineBodies(reader, baseline.asteroids, ticks, NET_ASTEROIDS, out.asteroids)
+           && readBaselineBodies(reader, baseline.bullets, ticks, NET_BULLETS, out.bullets)
+           && readFreshBodies(reader, NET_BULLETS, out.bullets)
+           && readFreshBodies(reader, NET_ASTEROIDS, out.asteroids);
+    sortBodies(out.asteroids);
+    sortBodies(out.bullets);
+    return ok && !reader.failed();
+}
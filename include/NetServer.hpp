@@ -0,0 +1,272 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "ArenaSimulation.hpp"
+#include "NetProtocol.hpp"
+#include "NetSocket.hpp"
+
+// Servidor autoritativo: simula el mundo de varias naves a 60 Hz con las
+// entradas que mandan los clientes y les manda fotos comprimidas contra la
+// última que cada uno ha confirmado. No tiene reloj propio: quien lo usa
+// llama a tick() a NET_TICK_DT (la herramienta shoot_server o net_test).
+
+// Entradas adelantadas que se guardan por cliente (búfer contra el jitter)
+constexpr std::uint32_t NET_INPUT_WINDOW = 64;
+// Si el cliente va más de tantos ticks por delante, se salta entradas para
+// no acumular retraso
+constexpr std::uint32_t NET_INPUT_MAX_BUFFERED = 8;
+constexpr std::uint32_t NET_INPUT_TARGET_BUFFERED = 2;
+
+struct NetServerConfig {
+    unsigned short port = NET_DEFAULT_PORT;
+    std::uint32_t seed = 1;
+    ArenaConfig arena;
+    std::uint32_t snapshotInterval = 3;  // Ticks entre fotos (20 Hz)
+    float timeout = 5.0f;                // Segundos sin noticias para soltar a un cliente
+    NetConditions conditions;
+};
+
+struct NetServerStats {
+    std::uint64_t snapshots = 0;
+    std::uint64_t snapshotBytes = 0;
+    size_t maxSnapshotBytes = 0;
+    std::uint64_t deferredBodies = 0;   // Altas aplazadas por no caber en el paquete
+    std::uint64_t fullSnapshots = 0;    // Fotos sin baseline
+    std::uint64_t missingInputs = 0;    // Ticks en que se repitió la entrada anterior
+    std::uint64_t skippedInputs = 0;    // Entradas saltadas por ir demasiado por delante
+    std::uint64_t joins = 0;
+    std::uint64_t timeouts = 0;
+};
+
+class NetServer {
+public:
+    explicit NetServer(const NetServerConfig& config)
+        : config(limitConfig(config)),
+          world(config.seed, this->config.arena),
+          socket(config.conditions, config.seed) {}
+
+    bool start() {
+        return socket.bind(config.port);
+    }
+
+    // Un tick: atiende los paquetes, simula y manda fotos si toca
+    void tick() {
+        receivePackets();
+
+        std::array<std::uint8_t, ARENA_MAX_SHIPS> inputs{};
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            if (peers[i].connected) {
+                inputs[i] = nextInput(peers[i]);
+            }
+        }
+        world.step(inputs.data(), NET_TICK_DT);
+
+        if (world.tick % config.snapshotInterval == 0) {
+            sendSnapshots();
+        }
+        dropSilentPeers();
+        socket.update();
+    }
+
+    int clientCount() const {
+        int count = 0;
+        for (const Peer& peer : peers) {
+            count += peer.connected ? 1 : 0;
+        }
+        return count;
+    }
+
+    const ArenaSimulation& arena() const { return world; }
+    const NetSocketStats& transport() const { return socket.stats; }
+
+    NetServerStats stats;
+
+private:
+    struct Peer {
+        bool connected = false;
+        sf::IpAddress address;
+        unsigned short port = 0;
+        std::uint64_t lastHeard = 0;  // Tick del último paquete
+        // Entradas recibidas por número de secuencia
+        std::array<std::uint32_t, NET_INPUT_WINDOW> inputSeq{};
+        std::array<std::uint8_t, NET_INPUT_WINDOW> inputs{};
+        std::uint32_t newestInput = 0;
+        std::uint32_t lastProcessed = 0;
+        std::uint8_t lastInput = 0;
+        // Fotos enviadas (tal como las reconstruirá el cliente) y la última confirmada
+        std::array<NetWorldState, NET_SNAPSHOT_HISTORY> history;
+        size_t nextHistory = 0;
+        std::uint32_t ackedTick = 0;
+    };
+
+    // Los slots de los pools tienen que caber en los bits del protocolo
+    static NetServerConfig limitConfig(NetServerConfig config) {
+        config.arena.maxAsteroids = std::min(config.arena.maxAsteroids, 1u << NET_ASTEROIDS.slotBits);
+        config.arena.maxBullets = std::min(config.arena.maxBullets, 1u << NET_BULLETS.slotBits);
+        config.snapshotInterval = std::max(config.snapshotInterval, 1u);
+        return config;
+    }
+
+    int findPeer(const sf::IpAddress& address, unsigned short port) const {
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            if (peers[i].connected && peers[i].address == address && peers[i].port == port) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void receivePackets() {
+        sf::IpAddress address;
+        unsigned short port = 0;
+        size_t size = 0;
+        while (socket.receive(packet.data(), packet.size(), size, address, port)) {
+            BitReader reader(packet.data(), size);
+            NetMessage type;
+            if (!readPacketHeader(reader, type)) {
+                continue;
+            }
+            int ship = findPeer(address, port);
+            if (type == NetMessage::Hello) {
+                if (ship < 0) {
+                    ship = world.join();
+                    if (ship >= 0) {
+                        peers[ship] = Peer();
+                        peers[ship].connected = true;
+                        peers[ship].address = address;
+                        peers[ship].port = port;
+                        stats.joins++;
+                    }
+                }
+                sendWelcome(ship, address, port);
+            } else if (ship < 0) {
+                continue;
+            } else if (type == NetMessage::Input) {
+                readInput(reader, peers[ship]);
+            } else if (type == NetMessage::Bye) {
+                disconnect(ship);
+                continue;
+            }
+            if (ship >= 0) {
+                peers[ship].lastHeard = world.tick;
+            }
+        }
+    }
+
+    void sendWelcome(int ship, const sf::IpAddress& address, unsigned short port) {
+        BitWriter writer(packet.data(), packet.size());
+        writePacketHeader(writer, ship >= 0 ? NetMessage::Welcome : NetMessage::Full);
+        writer.write(static_cast<std::uint32_t>(std::max(ship, 0)), NET_SHIP_BITS);
+        writer.write(static_cast<std::uint32_t>(world.tick), 32);
+        socket.send(packet.data(), writer.bytes(), address, port);
+    }
+
+    // Foto confirmada, la secuencia más nueva y las últimas entradas
+    void readInput(BitReader& reader, Peer& peer) {
+        std::uint32_t ackedTick = reader.read(32);
+        std::uint32_t newest = reader.read(32);
+        std::uint32_t count = reader.read(4);
+        for (std::uint32_t k = 0; k < count && !reader.failed(); k++) {
+            std::uint8_t input = static_cast<std::uint8_t>(reader.read(4));
+            std::uint32_t seq = newest - k;
+            if (seq == 0 || seq <= peer.lastProcessed || reader.failed()) {
+                continue;
+            }
+            peer.inputSeq[seq % NET_INPUT_WINDOW] = seq;
+            peer.inputs[seq % NET_INPUT_WINDOW] = input;
+        }
+        if (reader.failed()) {
+            return;
+        }
+        peer.newestInput = std::max(peer.newestInput, newest);
+        peer.ackedTick = std::max(peer.ackedTick, ackedTick);
+    }
+
+    // Una entrada por tick y cliente, en orden. Si la siguiente no ha llegado
+    // se repite la última (la predicción del cliente lo corrige después).
+    std::uint8_t nextInput(Peer& peer) {
+        if (peer.newestInput > peer.lastProcessed + NET_INPUT_MAX_BUFFERED) {
+            std::uint32_t target = peer.newestInput - NET_INPUT_TARGET_BUFFERED;
+            stats.skippedInputs += target - peer.lastProcessed;
+            peer.lastProcessed = target;
+        }
+        std::uint32_t next = peer.lastProcessed + 1;
+        if (peer.inputSeq[next % NET_INPUT_WINDOW] == next) {
+            peer.lastInput = peer.inputs[next % NET_INPUT_WINDOW];
+            peer.lastProcessed = next;
+        } else if (peer.newestInput > 0) {
+            stats.missingInputs++;
+        }
+        return peer.lastInput;
+    }
+
+    void sendSnapshots() {
+        buildNetWorldState(world, current);
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            Peer& peer = peers[i];
+            if (!peer.connected) {
+                continue;
+            }
+            // Baseline: la última foto confirmada, si sigue en el historial
+            // y no es el hueco que se va a sobrescribir
+            const NetWorldState* baseline = &empty;
+            for (size_t h = 0; h < NET_SNAPSHOT_HISTORY; h++) {
+                if (peer.ackedTick != 0 && peer.history[h].tick == peer.ackedTick && h != peer.nextHistory) {
+                    baseline = &peer.history[h];
+                }
+            }
+            NetSnapshotHeader header;
+            header.tick = current.tick;
+            header.baselineTick = baseline->tick;
+            header.lastProcessedInput = peer.lastProcessed;
+            header.ship = i;
+            NetWorldState& sent = peer.history[peer.nextHistory];
+            NetEncodeResult result = encodeSnapshot(header, *baseline, current, sent, packet.data(), packet.size());
+            if (result.bytes == 0 && baseline != &empty) {
+                // Las correcciones de la baseline no caben (cuanto más vieja,
+                // más crecen): se manda completa, que siempre cabe porque los
+                // cuerpos nuevos que sobran se aplazan
+                baseline = &empty;
+                header.baselineTick = 0;
+                result = encodeSnapshot(header, *baseline, current, sent, packet.data(), packet.size());
+            }
+            if (result.bytes == 0) {
+                continue;
+            }
+            peer.nextHistory = (peer.nextHistory + 1) % NET_SNAPSHOT_HISTORY;
+            socket.send(packet.data(), result.bytes, peer.address, peer.port);
+            stats.snapshots++;
+            stats.snapshotBytes += result.bytes;
+            stats.maxSnapshotBytes = std::max(stats.maxSnapshotBytes, result.bytes);
+            stats.deferredBodies += result.deferred;
+            stats.fullSnapshots += baseline->tick == 0 ? 1 : 0;
+        }
+    }
+
+    void dropSilentPeers() {
+        const std::uint64_t limit = static_cast<std::uint64_t>(config.timeout / NET_TICK_DT);
+        for (int i = 0; i < ARENA_MAX_SHIPS; i++) {
+            if (peers[i].connected && world.tick - peers[i].lastHeard > limit) {
+                stats.timeouts++;
+                disconnect(i);
+            }
+        }
+    }
+
+    void disconnect(int ship) {
+        peers[ship].connected = false;
+        world.leave(ship);
+    }
+
+    NetServerConfig config;
+    ArenaSimulation world;
+    NetSocket socket;
+    std::array<Peer, ARENA_MAX_SHIPS> peers;
+    std::array<std::uint8_t, NET_MAX_PACKET> packet{};
+    NetWorldState current;
+    NetWorldState empty;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// Condiciones de red simuladas para probar en localhost: cada paquete que
+// sale se pierde con probabilidad 'loss' o se retrasa latency ± jitter.
+// Con jitter los paquetes pueden llegar desordenados, como en una red real.
+struct NetConditions {
+    float loss = 0.0f;       // 0..1
+    float latencyMs = 0.0f;  // Solo ida
+    float jitterMs = 0.0f;
+
+    bool active() const { return loss > 0.0f || latencyMs > 0.0f || jitterMs > 0.0f; }
+};
+
+struct NetSocketStats {
+    std::uint64_t packetsSent = 0;
+    std::uint64_t packetsDropped = 0;  // Perdidos a propósito por las condiciones
+    std::uint64_t bytesSent = 0;
+    std::uint64_t packetsReceived = 0;
+    std::uint64_t bytesReceived = 0;
+};
+
+// Socket UDP sin bloqueo con el simulador de condiciones en el envío
+class NetSocket {
+public:
+    explicit NetSocket(const NetConditions& conditions = NetConditions(), std::uint32_t seed = 1)
+        : conditions(conditions), rng(seed) {
+        socket.setBlocking(false);
+    }
+
+    // Puerto 0: cualquiera libre (clientes)
+    bool bind(unsigned short port) {
+        return socket.bind(port) == sf::Socket::Done;
+    }
+
+    unsigned short localPort() const { return socket.getLocalPort(); }
+
+    void send(const std::uint8_t* data, size_t size, const sf::IpAddress& address, unsigned short port) {
+        stats.packetsSent++;
+        stats.bytesSent += size;
+        if (!conditions.active()) {
+            socket.send(data, size, address, port);
+            return;
+        }
+        if (chance(rng) < conditions.loss) {
+            stats.packetsDropped++;
+            return;
+        }
+        float delayMs = conditions.latencyMs + (chance(rng) * 2.0f - 1.0f) * conditions.jitterMs;
+        Delayed packet;
+        packet.due = Clock::now() + std::chrono::microseconds(static_cast<long long>(std::max(delayMs, 0.0f) * 1000.0f));
+        packet.data.assign(data, data + size);
+        packet.address = address;
+        packet.port = port;
+        // Ordenados por hora de salida
+        auto it = delayed.end();
+        while (it != delayed.begin() && std::prev(it)->due > packet.due) {
+            --it;
+        }
+        delayed.insert(it, std::move(packet));
+    }
+
+    // Envía los paquetes retrasados que ya tocan
+    void update() {
+        Clock::time_point now = Clock::now();
+        while (!delayed.empty() && delayed.front().due <= now) {
+            const Delayed& packet = delayed.front();
+            socket.send(packet.data.data(), packet.data.size(), packet.address, packet.port);
+            delayed.pop_front();
+        }
+    }
+
+    // Un paquete recibido, si hay alguno esperando
+    bool receive(std::uint8_t* data, size_t capacity, size_t& size, sf::IpAddress& address, unsigned short& port) {
+        if (socket.receive(data, capacity, size, address, port) != sf::Socket::Done) {
+            return false;
+        }
+        stats.packetsReceived++;
+        stats.bytesReceived += size;
+        return true;
+    }
+
+    NetSocketStats stats;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Delayed {
+        Clock::time_point due;
+        std::vector<std::uint8_t> data;
+        sf::IpAddress address;
+        unsigned short port = 0;
+    };
+
+    sf::UdpSocket socket;
+    NetConditions conditions;
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> chance{ 0.0f, 1.0f };
+    std::deque<Delayed> delayed;
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AngleMath.hpp"
+#include "EntityArrays.hpp"
+
+// Partículas de efectos (explosiones, estela de la nave). Solo son visuales:
+// viven en el hilo de render, avanzan con el dt del frame y no tocan la
+// simulación, así que no afectan al determinismo ni a las grabaciones.
+//
+// Igual que las entidades, van en estructura de arrays, pero el pool es de
+// capacidad fija desde el principio: los arrays se reservan una vez y emitir
+// o apagar una partícula no reserva memoria. Si el pool está lleno, las
+// partículas nuevas se descartan.
+
+constexpr std::uint32_t PARTICLE_CAPACITY = 131072;
+// Frenado: la velocidad se multiplica por exp(-PARTICLE_DRAG * dt)
+constexpr float PARTICLE_DRAG = 2.0f;
+// Medio lado del cuadrado de cada partícula
+constexpr float PARTICLE_HALF_SIZE = 1.0f;
+
+// Posición, velocidad, vida restante, inversa de la vida inicial (para el
+// desvanecido) y color RGB empaquetado como 0xRRGGBB00
+struct ParticleArrays {
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;
+    std::vector<float> fade;
+    std::vector<std::uint32_t> color;
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return x.size(); }
+
+    void allocate(size_t n) {
+        x.assign(n, 0.0f); y.assign(n, 0.0f);
+        vx.assign(n, 0.0f); vy.assign(n, 0.0f);
+        life.assign(n, 0.0f);
+        fade.assign(n, 0.0f);
+        color.assign(n, 0);
+        count = 0;
+    }
+
+    bool push(const sf::Vector2f& position, const sf::Vector2f& velocity, float lifetime, std::uint32_t rgb) {
+        if (count == capacity()) {
+            return false;
+        }
+        x[count] = position.x; y[count] = position.y;
+        vx[count] = velocity.x; vy[count] = velocity.y;
+        life[count] = lifetime;
+        fade[count] = 1.0f / lifetime;
+        color[count] = rgb;
+        ++count;
+        return true;
+    }
+
+    void swapRemove(size_t i) {
+        size_t last = --count;
+        x[i] = x[last]; y[i] = y[last];
+        vx[i] = vx[last]; vy[i] = vy[last];
+        life[i] = life[last];
+        fade[i] = fade[last];
+        color[i] = color[last];
+    }
+
+    void clear() {
+        count = 0;
+    }
+
+    sf::Vector2f position(size_t i) const { return { x[i], y[i] }; }
+
+    // Opacidad (0..1): baja en línea recta hasta apagarse
+    float opacity(size_t i) const { return std::min(life[i] * fade[i], 1.0f); }
+};
+
+// position += velocity * dt; velocity *= damping; life -= dt
+inline void integrateParticles(ParticleArrays& p, float damping, float dt,
+                               size_t begin = 0, size_t end = SIZE_MAX) {
+    const size_t n = std::min(end, p.size());
+    size_t i = begin;
+#if SHOOT_SIMD_WIDTH == 8
+    const __m256 vDt = _mm256_set1_ps(dt);
+    const __m256 vDamping = _mm256_set1_ps(damping);
+    for (; i + 8 <= n; i += 8) {
+        __m256 vx = _mm256_loadu_ps(&p.vx[i]);
+        __m256 vy = _mm256_loadu_ps(&p.vy[i]);
+        _mm256_storeu_ps(&p.x[i], _mm256_add_ps(_mm256_loadu_ps(&p.x[i]), _mm256_mul_ps(vx, vDt)));
+        _mm256_storeu_ps(&p.y[i], _mm256_add_ps(_mm256_loadu_ps(&p.y[i]), _mm256_mul_ps(vy, vDt)));
+        _mm256_storeu_ps(&p.vx[i], _mm256_mul_ps(vx, vDamping));
+        _mm256_storeu_ps(&p.vy[i], _mm256_mul_ps(vy, vDamping));
+        _mm256_storeu_ps(&p.life[i], _mm256_sub_ps(_mm256_loadu_ps(&p.life[i]), vDt));
+    }
+#elif SHOOT_SIMD_WIDTH == 4
+    const __m128 vDt = _mm_set1_ps(dt);
+    const __m128 vDamping = _mm_set1_ps(damping);
+    for (; i + 4 <= n; i += 4) {
+        __m128 vx = _mm_loadu_ps(&p.vx[i]);
+        __m128 vy = _mm_loadu_ps(&p.vy[i]);
+        _mm_storeu_ps(&p.x[i], _mm_add_ps(_mm_loadu_ps(&p.x[i]), _mm_mul_ps(vx, vDt)));
+        _mm_storeu_ps(&p.y[i], _mm_add_ps(_mm_loadu_ps(&p.y[i]), _mm_mul_ps(vy, vDt)));
+        _mm_storeu_ps(&p.vx[i], _mm_mul_ps(vx, vDamping));
+        _mm_storeu_ps(&p.vy[i], _mm_mul_ps(vy, vDamping));
+        _mm_storeu_ps(&p.life[i], _mm_sub_ps(_mm_loadu_ps(&p.life[i]), vDt));
+    }
+#endif
+    // Resto escalar (y camino completo si no hay SIMD)
+    for (; i < n; ++i) {
+        p.x[i] += p.vx[i] * dt;
+        p.y[i] += p.vy[i] * dt;
+        p.vx[i] *= damping;
+        p.vy[i] *= damping;
+        p.life[i] -= dt;
+    }
+}
+
+// Pool de partículas con sus emisores. La aleatoriedad es un xorshift
+// propio: barato y sin estado compartido con la simulación.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(std::uint32_t capacity = PARTICLE_CAPACITY, std::uint32_t seed = 1)
+        : state(seed ? seed : 1) {
+        arrays.allocate(capacity);
+    }
+
+    // Chispas en todas direcciones desde 'position'. Cada una sale con una
+    // velocidad entre el 20% y el 100% de 'speed' y vive entre la mitad y
+    // el total de 'lifetime'.
+    void burst(const sf::Vector2f& position, std::uint32_t count, float speed, float lifetime, std::uint32_t rgb) {
+        emit(position, 0, 0xFFFFFFFFu, count, speed, lifetime, rgb);
+    }
+
+    // Chorro hacia 'angle', abierto 'spread' a cada lado
+    void jet(const sf::Vector2f& position, BinaryAngle angle, BinaryAngle spread, std::uint32_t count, float speed,
+             float lifetime, std::uint32_t rgb) {
+        emit(position, angle - spread, 2 * spread, count, speed, lifetime, rgb);
+    }
+
+    // Avanza todas las partículas y quita las que se han apagado
+    void update(float dt) {
+        integrateParticles(arrays, std::exp(-PARTICLE_DRAG * dt), dt);
+        size_t i = 0;
+        while (i < arrays.size()) {
+            if (arrays.life[i] <= 0.0f) {
+                arrays.swapRemove(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    void clear() {
+        arrays.clear();
+    }
+
+    size_t size() const { return arrays.size(); }
+    size_t capacity() const { return arrays.capacity(); }
+
+    ParticleArrays arrays;
+    std::uint64_t dropped = 0;  // Partículas descartadas con el pool lleno
+
+private:
+    void emit(const sf::Vector2f& position, BinaryAngle fromAngle, BinaryAngle arc, std::uint32_t count, float speed,
+              float lifetime, std::uint32_t rgb) {
+        for (std::uint32_t k = 0; k < count; ++k) {
+            BinaryAngle angle = fromAngle + static_cast<BinaryAngle>((static_cast<std::uint64_t>(arc) * next()) >> 32);
+            float v = speed * (0.2f + 0.8f * random());
+            sf::Vector2f velocity = angleDirection(angle) * v;
+            if (!arrays.push(position, velocity, lifetime * (0.5f + 0.5f * random()), rgb)) {
+                dropped += count - k;
+                return;
+            }
+        }
+    }
+
+    std::uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Uniforme en [0, 1)
+    float random() {
+        return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    std::uint32_t state;
+};
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <chipmunk/chipmunk.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Ball.hpp"
+#include "GameConfig.hpp"
+#include "PhysicsSpace.hpp"
+#include "Simulation.hpp"
+
+// Misma partida que Simulation, pero con Chipmunk haciendo el movimiento y
+// las colisiones: balas y asteroides son cuerpos de un PhysicsSpace sin
+// gravedad, con hash espacial como broadphase, y los choques llegan por
+// manejadores de colisión que apuntan bajas, puntaje y game over. Los
+// asteroides usan las mismas piezas convexas que el casco de Simulation.
+//
+// Expone el mismo estado que Simulation (pools SoA incluidos, que se copian
+// de los cuerpos en cada tick) para que el render y SimulationThread sirvan
+// sin cambios. Chipmunk va en un solo hilo: el JobSystem se ignora.
+//
+// Los cuerpos de las balas se crean una vez, uno por slot, y disparar o
+// quitar una bala solo los mete o saca del espacio. Como la nave dispara
+// como mucho una bala cada SHOOT_DELAY y duran BULLET_LIFE, basta con
+// PHYSICS_MAX_BULLETS slots.
+constexpr std::uint32_t PHYSICS_MAX_BULLETS = static_cast<std::uint32_t>(BULLET_LIFE / SHOOT_DELAY) + 2;
+
+class PhysicsSimulation {
+public:
+    explicit PhysicsSimulation(std::uint32_t seed, const SimConfig& config = SimConfig(), JobSystem* = nullptr)
+        : bullets(std::min(config.maxBullets, PHYSICS_MAX_BULLETS)),
+          asteroids(config.maxAsteroids),
+          space(cpvzero),
+          config(config),
+          asteroidHull(asteroidCollisionHull()),
+          playerHull(playerCollisionHull()),
+          bulletBodies(bullets.capacity()),
+          asteroidBodies(config.maxAsteroids),
+          asteroidHit(config.maxAsteroids, 0) {
+        space.useSpatialHash(ASTEROID_W, SPATIAL_HASH_CELLS);
+
+        // Un cuerpo por slot de bala, fuera del espacio hasta que se dispare
+        for (std::uint32_t slot = 0; slot < bulletBodies.size(); ++slot) {
+            BulletBody& entry = bulletBodies[slot];
+            entry.ball = std::make_unique<Ball>(space.getSpace(), BULLET_RADIUS, 1.0f, cpvzero);
+            cpBodySetUserData(entry.ball->getBody(), slotData(slot));
+            cpShapeSetCollisionType(entry.ball->getPhysicsShape(), BULLET_TYPE);
+            cpShapeSetFilter(entry.ball->getPhysicsShape(), cpShapeFilterNew(0, BULLET_CATEGORY, ASTEROID_CATEGORY));
+            entry.ball->removeFromSpace();
+        }
+
+        cpCollisionHandler* bulletHits = cpSpaceAddCollisionHandler(space.getSpace(), BULLET_TYPE, ASTEROID_TYPE);
+        bulletHits->beginFunc = &PhysicsSimulation::bulletHitsAsteroid;
+        bulletHits->userData = this;
+        cpCollisionHandler* playerHits = cpSpaceAddCollisionHandler(space.getSpace(), PLAYER_TYPE, ASTEROID_TYPE);
+        playerHits->beginFunc = &PhysicsSimulation::playerHitsAsteroid;
+        playerHits->userData = this;
+
+        // La nave es cinemática: se coloca a mano y empuja sin ser empujada
+        playerBody = cpSpaceAddBody(space.getSpace(), cpBodyNewKinematic());
+        for (int p = 0; p < playerHull.getPieceCount(); ++p) {
+            cpShape* shape = addPiece(playerBody, playerHull.getPiece(p));
+            cpShapeSetCollisionType(shape, PLAYER_TYPE);
+            cpShapeSetFilter(shape, cpShapeFilterNew(0, PLAYER_CATEGORY, ASTEROID_CATEGORY));
+            playerShapes.push_back(shape);
+        }
+
+        bulletKills.reserve(SIM_CHUNK_SIZE);
+        asteroidKills.reserve(SIM_CHUNK_SIZE);
+        expired.reserve(SIM_CHUNK_SIZE);
+        bulletSpawns.reserve(16);
+        explosions.reserve(64);
+        reset(seed);
+    }
+
+    ~PhysicsSimulation() {
+        removeAll();
+        for (cpShape* shape : playerShapes) {
+            cpSpaceRemoveShape(space.getSpace(), shape);
+            cpShapeFree(shape);
+        }
+        cpSpaceRemoveBody(space.getSpace(), playerBody);
+        cpBodyFree(playerBody);
+    }
+
+    PhysicsSimulation(const PhysicsSimulation&) = delete;
+    PhysicsSimulation& operator=(const PhysicsSimulation&) = delete;
+
+    void setProfiler(Profiler* value) {
+        profiler = value;
+    }
+
+    // Nueva partida con otra semilla
+    void reset(std::uint32_t seed) {
+        rng.seed(seed);
+        restart();
+    }
+
+    // Nueva partida continuando la secuencia aleatoria actual
+    void restart() {
+        removeAll();
+        player = PlayerState();
+        score = 0;
+        gameOver = false;
+        tick = 0;
+        events = TickEvents();
+        explosions.clear();
+        asteroidSpawnTime = config.asteroidSpawnTime;
+        for (std::uint32_t i = 0; i < config.initialAsteroids; i++) {
+            spawnAsteroid();
+        }
+    }
+
+    // Avanza un tick de duración dt con la entrada indicada
+    void step(std::uint8_t input, float dt) {
+        events = TickEvents();
+        explosions.clear();
+        if (gameOver) {
+            return;
+        }
+        ++tick;
+
+        {
+            ProfileScope scope(profiler, ProfilePhase::Spawn);
+            asteroidSpawnTime -= dt;
+            if (asteroidSpawnTime <= 0.0f) {
+                asteroidSpawnTime = config.asteroidSpawnTime;
+                spawnAsteroid();
+            }
+        }
+        {
+            ProfileScope scope(profiler, ProfilePhase::Player);
+            advancePlayer(player, input, dt, bulletSpawns, events);
+            cpBodySetPosition(playerBody, cpv(player.position.x, player.position.y));
+            cpBodySetAngle(playerBody, angleToRadians(player.angle));
+        }
+        {
+            // Movimiento, broadphase y narrowphase: todo dentro de Chipmunk
+            ProfileScope scope(profiler, ProfilePhase::Narrowphase);
+            space.step(dt);
+        }
+        {
+            ProfileScope scope(profiler, ProfilePhase::Integrate);
+            syncBullets(dt);
+            syncAsteroids();
+        }
+        applyKills();
+    }
+
+    // Chipmunk solo simula el mundo del tamaño de la ventana
+    // (SimConfig::worldWidth/worldHeight y farTickInterval no se usan), así
+    // que la consulta por zona recorre todos los asteroides
+    template <typename Fn>
+    void queryAsteroids(const BounceBounds& area, Fn&& fn) const {
+        const AsteroidArrays& a = asteroids.arrays;
+        for (std::uint32_t i = 0; i < a.size(); i++) {
+            if (insideBounds(area, a.x[i], a.y[i])) {
+                fn(i);
+            }
+        }
+    }
+
+    sf::Vector2f worldSize() const { return { SCREEN_WIDTH, SCREEN_HEIGHT }; }
+    const BounceBounds& asteroidBounds() const { return ASTEROID_BOUNDS; }
+
+    // Estado visible (el mismo que Simulation)
+    PlayerState player;
+    EntityPool<BulletArrays> bullets;
+    EntityPool<AsteroidArrays> asteroids;
+    int score = 0;
+    bool gameOver = false;
+    std::uint64_t tick = 0;
+    TickEvents events;
+    std::vector<sf::Vector2f> explosions;  // Dónde se destruyó cada asteroide del último tick
+    CollisionStats stats;  // Chipmunk no cuenta los pares que prueba: solo pairsHit
+
+private:
+    static constexpr cpCollisionType BULLET_TYPE = 1;
+    static constexpr cpCollisionType ASTEROID_TYPE = 2;
+    static constexpr cpCollisionType PLAYER_TYPE = 3;
+    static constexpr cpBitmask BULLET_CATEGORY = 1 << 0;
+    static constexpr cpBitmask ASTEROID_CATEGORY = 1 << 1;
+    static constexpr cpBitmask PLAYER_CATEGORY = 1 << 2;
+    static constexpr int SPATIAL_HASH_CELLS = 8192;
+
+    // Cuerpo de una bala (un Ball, creado una vez) y el handle de su
+    // entidad. 'hit': ya ha destruido un asteroide en este paso.
+    struct BulletBody {
+        std::unique_ptr<Ball> ball;
+        EntityHandle handle;
+        bool hit = false;
+    };
+
+    // Cuerpo de un asteroide, sus piezas convexas y el handle de su entidad
+    struct AsteroidBody {
+        cpBody* body = nullptr;
+        cpShape* shapes[HULL_MAX_PIECES] = {};
+        int shapeCount = 0;
+        EntityHandle handle;
+    };
+
+    // El slot del handle va en los datos de usuario del cuerpo
+    static std::uint32_t slotOf(cpBody* body) {
+        return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(cpBodyGetUserData(body)));
+    }
+
+    static cpDataPointer slotData(std::uint32_t slot) {
+        return reinterpret_cast<cpDataPointer>(static_cast<std::uintptr_t>(slot));
+    }
+
+    // Manejadores: se anotan las bajas y se rechaza el choque (no hay rebote);
+    // los cuerpos se quitan después del paso, fuera de la llamada de Chipmunk.
+    // Como en Simulation, cada bala destruye un solo asteroide y un asteroide
+    // ya destruido no para más balas.
+    static cpBool bulletHitsAsteroid(cpArbiter* arbiter, cpSpace*, cpDataPointer data) {
+        PhysicsSimulation* self = static_cast<PhysicsSimulation*>(data);
+        cpBody* bullet;
+        cpBody* asteroid;
+        cpArbiterGetBodies(arbiter, &bullet, &asteroid);
+        BulletBody& bulletEntry = self->bulletBodies[slotOf(bullet)];
+        std::uint8_t& asteroidUsed = self->asteroidHit[slotOf(asteroid)];
+        if (bulletEntry.hit || asteroidUsed) {
+            return cpFalse;
+        }
+        bulletEntry.hit = true;
+        asteroidUsed = 1;
+        self->bulletKills.push_back(bulletEntry.handle);
+        self->asteroidKills.push_back(self->asteroidBodies[slotOf(asteroid)].handle);
+        ++self->stats.pairsHit;
+        return cpFalse;
+    }
+
+    static cpBool playerHitsAsteroid(cpArbiter*, cpSpace*, cpDataPointer data) {
+        PhysicsSimulation* self = static_cast<PhysicsSimulation*>(data);
+        ++self->stats.pairsHit;
+        if (!self->config.invulnerable) {
+            self->gameOver = true;  // El juego ha terminado
+        }
+        return cpFalse;
+    }
+
+    cpShape* addPiece(cpBody* body, const ConvexPiece& piece) {
+        cpVect verts[HULL_MAX_VERTS];
+        for (int v = 0; v < piece.count; ++v) {
+            verts[v] = cpv(piece.verts[v].x, piece.verts[v].y);
+        }
+        return cpSpaceAddShape(space.getSpace(), cpPolyShapeNew(body, piece.count, verts, cpTransformIdentity, 0.0));
+    }
+
+    void spawnAsteroid() {
+        sf::Vector2f position = randomAsteroidPosition(rng);
+        sf::Vector2f direction = randomAsteroidDirection(rng);
+        EntityHandle handle = asteroids.spawn(position, direction);
+        if (!handle.valid()) {
+            return;
+        }
+        AsteroidBody& entry = asteroidBodies[handle.slot];
+        entry.handle = handle;
+        asteroidHit[handle.slot] = 0;
+        entry.body = cpSpaceAddBody(space.getSpace(), cpBodyNew(1.0, cpMomentForCircle(1.0, 0, ASTEROID_W / 2.0f, cpvzero)));
+        cpBodySetPosition(entry.body, cpv(position.x, position.y));
+        cpBodySetVelocity(entry.body, cpv(direction.x * ASTEROID_SPEED, direction.y * ASTEROID_SPEED));
+        cpBodySetAngularVelocity(entry.body, ASTEROID_SPIN * (M_P / 180.0f));
+        cpBodySetUserData(entry.body, slotData(handle.slot));
+        entry.shapeCount = asteroidHull.getPieceCount();
+        for (int p = 0; p < entry.shapeCount; ++p) {
+            entry.shapes[p] = addPiece(entry.body, asteroidHull.getPiece(p));
+            cpShapeSetCollisionType(entry.shapes[p], ASTEROID_TYPE);
+            cpShapeSetFilter(entry.shapes[p], cpShapeFilterNew(0, ASTEROID_CATEGORY, BULLET_CATEGORY | PLAYER_CATEGORY));
+        }
+    }
+
+    void spawnBullet(const BulletSpawn& spawn) {
+        EntityHandle handle = bullets.spawn(spawn.position, spawn.direction, BULLET_LIFE);
+        if (!handle.valid()) {
+            return;
+        }
+        BulletBody& entry = bulletBodies[handle.slot];
+        entry.handle = handle;
+        entry.hit = false;
+        cpBody* body = entry.ball->getBody();
+        cpBodySetPosition(body, cpv(spawn.position.x, spawn.position.y));
+        cpBodySetVelocity(body, cpv(spawn.direction.x * BULLET_SPEED, spawn.direction.y * BULLET_SPEED));
+        cpBodySetAngularVelocity(body, 0.0);
+        cpBodySetAngle(body, 0.0);
+        entry.ball->addToSpace();
+    }
+
+    void killBullet(const EntityHandle& handle) {
+        if (bullets.kill(handle)) {
+            bulletBodies[handle.slot].ball->removeFromSpace();
+        }
+    }
+
+    bool killAsteroid(const EntityHandle& handle) {
+        if (!asteroids.kill(handle)) {
+            return false;
+        }
+        AsteroidBody& entry = asteroidBodies[handle.slot];
+        for (int p = 0; p < entry.shapeCount; ++p) {
+            cpSpaceRemoveShape(space.getSpace(), entry.shapes[p]);
+            cpShapeFree(entry.shapes[p]);
+        }
+        cpSpaceRemoveBody(space.getSpace(), entry.body);
+        cpBodyFree(entry.body);
+        entry = AsteroidBody();
+        return true;
+    }
+
+    void removeAll() {
+        while (bullets.size() > 0) {
+            killBullet(bullets.handleAt(bullets.size() - 1));
+        }
+        while (asteroids.size() > 0) {
+            killAsteroid(asteroids.handleAt(asteroids.size() - 1));
+        }
+    }
+
+    // Copia los cuerpos a los arrays SoA y apunta las balas caducadas
+    void syncBullets(float dt) {
+        BulletArrays& b = bullets.arrays;
+        for (size_t i = 0; i < b.size(); i++) {
+            cpVect position = cpBodyGetPosition(bulletBodies[bullets.handleAt(i).slot].ball->getBody());
+            b.x[i] = static_cast<float>(position.x);
+            b.y[i] = static_cast<float>(position.y);
+            b.life[i] -= dt;
+        }
+        collectExpiredBullets(b, expired);
+    }
+
+    // Igual que integrateAsteroids: si el centro acaba fuera de los límites
+    // en un eje, se invierte la velocidad en ese eje
+    void syncAsteroids() {
+        AsteroidArrays& a = asteroids.arrays;
+        for (size_t i = 0; i < a.size(); i++) {
+            cpBody* body = asteroidBodies[asteroids.handleAt(i).slot].body;
+            cpVect position = cpBodyGetPosition(body);
+            cpVect velocity = cpBodyGetVelocity(body);
+            if (position.x <= ASTEROID_BOUNDS.minX || position.x >= ASTEROID_BOUNDS.maxX) {
+                velocity.x = -velocity.x;
+            }
+            if (position.y <= ASTEROID_BOUNDS.minY || position.y >= ASTEROID_BOUNDS.maxY) {
+                velocity.y = -velocity.y;
+            }
+            cpBodySetVelocity(body, velocity);
+            a.x[i] = static_cast<float>(position.x);
+            a.y[i] = static_cast<float>(position.y);
+            a.dx[i] = static_cast<float>(velocity.x / ASTEROID_SPEED);
+            a.dy[i] = static_cast<float>(velocity.y / ASTEROID_SPEED);
+            a.angle[i] = angleFromRadians(cpBodyGetAngle(body));
+        }
+    }
+
+    // Bajas (las repetidas se ignoran) y después altas, como en Simulation
+    void applyKills() {
+        ProfileScope scope(profiler, ProfilePhase::Apply);
+        for (std::uint32_t index : expired) {
+            bulletKills.push_back(bullets.handleAt(index));
+        }
+        expired.clear();
+        for (auto& handle : bulletKills) {
+            killBullet(handle);
+        }
+        for (auto& handle : asteroidKills) {
+            if (asteroids.alive(handle)) {
+                explosions.push_back(asteroids.arrays.position(asteroids.indexOf(handle)));
+            }
+            if (killAsteroid(handle)) {
+                score += 20; // Incrementar puntaje al destruir un asteroide
+                ++events.kills;
+            }
+        }
+        bulletKills.clear();
+        asteroidKills.clear();
+
+        for (auto& spawn : bulletSpawns) {
+            spawnBullet(spawn);
+        }
+        bulletSpawns.clear();
+    }
+
+    // El espacio se declara antes que los cuerpos: se destruye después
+    PhysicsSpace space;
+    SimConfig config;
+    Profiler* profiler = nullptr;
+    const CollisionHull& asteroidHull;
+    const CollisionHull& playerHull;
+    std::mt19937 rng;
+    float asteroidSpawnTime = 0.0f;
+
+    cpBody* playerBody = nullptr;
+    std::vector<cpShape*> playerShapes;
+    std::vector<BulletBody> bulletBodies;      // por slot
+    std::vector<AsteroidBody> asteroidBodies;  // por slot
+    std::vector<std::uint8_t> asteroidHit;     // por slot: ya destruido por una bala en este paso
+
+    std::vector<EntityHandle> bulletKills;
+    std::vector<EntityHandle> asteroidKills;
+    std::vector<std::uint32_t> expired;
+    std::vector<BulletSpawn> bulletSpawns;
+};
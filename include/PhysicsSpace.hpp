@@ -1,9 +1,11 @@
+#pragma once
+
+#include <chipmunk/chipmunk.h>
 
 class PhysicsSpace {
 public:
-    PhysicsSpace() {
+    explicit PhysicsSpace(cpVect gravity = cpv(0, 1000)) {
         space = cpSpaceNew();
-        cpVect gravity = cpv(0, 1000);
         cpSpaceSetGravity(space, gravity);
     }
 
@@ -11,6 +13,19 @@ public:
         cpSpaceFree(space);
     }
 
+    PhysicsSpace(const PhysicsSpace&) = delete;
+    PhysicsSpace& operator=(const PhysicsSpace&) = delete;
+
+    // Cambia el broadphase por un hash espacial de celdas de tamaño cellSize
+    // (conviene que sea parecido al de los objetos) con 'cells' entradas
+    void useSpatialHash(cpFloat cellSize, int cells) {
+        cpSpaceUseSpatialHash(space, cellSize, cells);
+    }
+
+    void step(cpFloat dt) {
+        cpSpaceStep(space, dt);
+    }
+
     cpSpace* getSpace() {
         return space;
     }
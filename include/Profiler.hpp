@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Fases del frame que se miden. Las de la simulación pueden repetirse varias
+// veces en un frame (un tick por repetición); su tiempo se suma.
+enum class ProfilePhase : std::uint8_t {
+    Events,       // sondeo de eventos de la ventana
+    Spawn,        // generación de asteroides
+    Integrate,    // movimiento de balas y asteroides, balas caducadas
+    Player,       // nave y disparos
+    Broadphase,   // construcción de la rejilla
+    Narrowphase,  // balas contra asteroides y nave contra asteroides
+    Apply,        // bajas y altas de entidades, puntaje
+    Audio,        // peticiones al mezclador
+    Particles,    // emisión y movimiento de las partículas
+    Render,       // preparar y enviar los lotes y la interfaz
+    Present,      // window.display() (incluye la espera de vsync)
+    Count
+};
+
+constexpr std::size_t PROFILE_PHASE_COUNT = static_cast<std::size_t>(ProfilePhase::Count);
+
+inline const char* profilePhaseName(ProfilePhase phase) {
+    static const char* const names[PROFILE_PHASE_COUNT] = {
+        "events", "spawn", "integrate", "player", "broadphase",
+        "narrowphase", "apply", "audio", "particles", "render", "present"
+    };
+    return names[static_cast<std::size_t>(phase)];
+}
+
+// Número de reservas de memoria de este hilo. Lo incrementa el operator new
+// del ejecutable si lo reemplaza (Shoot.cpp lo hace); si no, queda a cero.
+// Es por hilo para que cada profiler (render, simulación) cuente solo las
+// suyas y no las de los demás hilos (audio, carga de recursos).
+inline thread_local std::uint64_t allocationCount = 0;
+
+// Contadores que el juego aporta al cerrar cada frame
+struct FrameCounters {
+    std::uint32_t bullets = 0;
+    std::uint32_t asteroids = 0;
+    std::uint64_t pairsTested = 0;
+};
+
+// Un tramo medido, en microsegundos desde el inicio de su frame
+struct ProfileSpan {
+    ProfilePhase phase;
+    std::uint32_t begin;
+    std::uint32_t duration;
+};
+
+constexpr std::size_t PROFILE_MAX_SPANS = 64;
+
+struct FrameRecord {
+    std::uint64_t index = 0;
+    std::uint64_t start = 0;     // microsegundos desde que se creó el profiler
+    std::uint32_t duration = 0;  // microsegundos
+    std::uint32_t phaseTime[PROFILE_PHASE_COUNT] = {};
+    FrameCounters counters;
+    std::uint64_t allocations = 0;
+    std::uint32_t spanCount = 0;
+    ProfileSpan spans[PROFILE_MAX_SPANS];
+};
+
+// Profiler de frames: guarda los últimos N frames en un buffer circular
+// reservado al principio (medir no reserva memoria). Cada frame guarda sus
+// tramos, el tiempo total por fase y los contadores. Se puede pedir el
+// percentil de cualquier fase y exportar todo a CSV o a JSON de Chrome
+// (chrome://tracing, Perfetto).
+//
+// Solo debe usarse desde un hilo (el que mide las fases).
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Profiler(std::size_t frameCapacity = 600)
+        : frames(std::max<std::size_t>(1, frameCapacity)), origin(Clock::now()) {
+        scratch.reserve(frames.size());
+    }
+
+    void beginFrame() {
+        FrameRecord& frame = frames[next];
+        frame = FrameRecord();
+        frame.index = frameIndex;
+        frameStart = Clock::now();
+        frame.start = micros(origin, frameStart);
+        frameAllocations = allocationCount;
+        inFrame = true;
+    }
+
+    void endFrame(const FrameCounters& counters) {
+        if (!inFrame) {
+            return;
+        }
+        FrameRecord& frame = frames[next];
+        frame.duration = static_cast<std::uint32_t>(micros(frameStart, Clock::now()));
+        frame.counters = counters;
+        frame.allocations = allocationCount - frameAllocations;
+        next = (next + 1) % frames.size();
+        count = std::min(count + 1, frames.size());
+        ++frameIndex;
+        inFrame = false;
+    }
+
+    // Lo llama ProfileScope al cerrarse
+    void record(ProfilePhase phase, Clock::time_point begin, Clock::time_point end) {
+        if (!inFrame) {
+            return;
+        }
+        FrameRecord& frame = frames[next];
+        std::uint32_t duration = static_cast<std::uint32_t>(micros(begin, end));
+        frame.phaseTime[static_cast<std::size_t>(phase)] += duration;
+        if (frame.spanCount < PROFILE_MAX_SPANS) {
+            frame.spans[frame.spanCount++] = { phase, static_cast<std::uint32_t>(micros(frameStart, begin)), duration };
+        }
+    }
+
+    // Frames guardados; frame(0) es el más antiguo
+    std::size_t size() const { return count; }
+    const FrameRecord& frame(std::size_t i) const {
+        return frames[(next + frames.size() - count + i) % frames.size()];
+    }
+
+    // Percentil p (0..1) en milisegundos del tiempo de una fase en los frames
+    // guardados
+    double phasePercentile(ProfilePhase phase, double p) {
+        scratch.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            scratch.push_back(frame(i).phaseTime[static_cast<std::size_t>(phase)]);
+        }
+        return percentileMs(p);
+    }
+
+    // Percentil p (0..1) en milisegundos de la duración del frame completo
+    double framePercentile(double p) {
+        scratch.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            scratch.push_back(frame(i).duration);
+        }
+        return percentileMs(p);
+    }
+
+    // Una fila por frame: tiempos en microsegundos y contadores
+    bool exportCsv(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        out << "frame,start_us,frame_us";
+        for (std::size_t p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+            out << ',' << profilePhaseName(static_cast<ProfilePhase>(p)) << "_us";
+        }
+        out << ",bullets,asteroids,pairs_tested,allocations\n";
+        for (std::size_t i = 0; i < count; ++i) {
+            const FrameRecord& f = frame(i);
+            out << f.index << ',' << f.start << ',' << f.duration;
+            for (std::size_t p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+                out << ',' << f.phaseTime[p];
+            }
+            out << ',' << f.counters.bullets << ',' << f.counters.asteroids << ',' << f.counters.pairsTested
+                << ',' << f.allocations << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    // Formato "Trace Event" de Chrome: un evento completo ("X") por frame y
+    // por tramo, y contadores ("C") de entidades, pares y reservas
+    bool exportTrace(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&]() {
+            if (!first) {
+                out << ",\n";
+            }
+            first = false;
+        };
+        for (std::size_t i = 0; i < count; ++i) {
+            const FrameRecord& f = frame(i);
+            separator();
+            out << "{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << f.start
+                << ",\"dur\":" << f.duration << ",\"args\":{\"index\":" << f.index << "}}";
+            for (std::uint32_t s = 0; s < f.spanCount; ++s) {
+                const ProfileSpan& span = f.spans[s];
+                separator();
+                out << "{\"name\":\"" << profilePhaseName(span.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+                    << f.start + span.begin << ",\"dur\":" << span.duration << "}";
+            }
+            separator();
+            out << "{\"name\":\"entities\",\"ph\":\"C\",\"pid\":1,\"ts\":" << f.start
+                << ",\"args\":{\"bullets\":" << f.counters.bullets << ",\"asteroids\":" << f.counters.asteroids << "}}";
+            separator();
+            out << "{\"name\":\"work\",\"ph\":\"C\",\"pid\":1,\"ts\":" << f.start
+                << ",\"args\":{\"pairs_tested\":" << f.counters.pairsTested << ",\"allocations\":" << f.allocations << "}}";
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    static std::uint64_t micros(Clock::time_point from, Clock::time_point to) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+    }
+
+    double percentileMs(double p) {
+        if (scratch.empty()) {
+            return 0.0;
+        }
+        std::size_t k = std::min(scratch.size() - 1, static_cast<std::size_t>(p * (scratch.size() - 1) + 0.5));
+        std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+        return scratch[k] / 1000.0;
+    }
+
+    std::vector<FrameRecord> frames;
+    std::vector<std::uint32_t> scratch;
+    std::size_t next = 0;
+    std::size_t count = 0;
+    std::uint64_t frameIndex = 0;
+    Clock::time_point origin;
+    Clock::time_point frameStart;
+    std::uint64_t frameAllocations = 0;
+    bool inFrame = false;
+};
+
+// Mide el bloque en el que vive. Con profiler nulo no hace nada, así el
+// mismo código sirve con y sin medición (por ejemplo, en shoot_headless).
+class ProfileScope {
+public:
+    ProfileScope(Profiler* profiler, ProfilePhase phase)
+        : profiler(profiler), phase(phase) {
+        if (profiler) {
+            begin = Profiler::Clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (profiler) {
+            profiler->record(phase, begin, Profiler::Clock::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler* profiler;
+    ProfilePhase phase;
+    Profiler::Clock::time_point begin;
+};
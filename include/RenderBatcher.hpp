@@ -0,0 +1,149 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "AngleMath.hpp"
+#include "ParticleSystem.hpp"
+
+// Malla de líneas inmutable, compartida por todas las instancias que la usan
+// (por ejemplo, todos los asteroides). Se guarda como puntos de una tira.
+class LineMesh {
+public:
+    LineMesh(const sf::Vector2f* strip, size_t count, sf::Color color = sf::Color::White)
+        : points(strip, strip + count), color(color) {}
+
+    size_t pointCount() const { return points.size(); }
+    size_t segmentCount() const { return points.empty() ? 0 : points.size() - 1; }
+    const sf::Vector2f& point(size_t i) const { return points[i]; }
+    sf::Color getColor() const { return color; }
+
+private:
+    const std::vector<sf::Vector2f> points;
+    const sf::Color color;
+};
+
+// Agrupa todo lo que se dibuja en un frame en unos pocos buffers de vértices.
+// Las instancias se transforman en la CPU y cada buffer se envía con una sola
+// llamada a draw, así que el número de draw calls no depende de cuántas
+// entidades haya. Los buffers solo crecen (nunca se liberan entre frames).
+class RenderBatcher {
+public:
+    explicit RenderBatcher(size_t initialLineVertices = 4096, size_t initialQuadVertices = 1024)
+        : lines(sf::Lines, initialLineVertices), quads(sf::Quads, initialQuadVertices), particleQuads(sf::Quads),
+          lineCount(0), quadCount(0), particleCount(0), drawCalls(0) {}
+
+    void begin() {
+        lineCount = 0;
+        quadCount = 0;
+        particleCount = 0;
+        drawCalls = 0;
+    }
+
+    // Añade una instancia de la malla trasladada a 'position' y girada 'angle'
+    void addMesh(const LineMesh& mesh, const sf::Vector2f& position, BinaryAngle angle) {
+        const size_t segments = mesh.segmentCount();
+        if (segments == 0) {
+            return;
+        }
+        ensure(lines, lineCount + segments * 2);
+
+        const float c = cosine(angle);
+        const float s = sine(angle);
+        const sf::Color color = mesh.getColor();
+
+        sf::Vector2f previous = transform(mesh.point(0), position, c, s);
+        for (size_t i = 1; i <= segments; ++i) {
+            sf::Vector2f current = transform(mesh.point(i), position, c, s);
+            sf::Vertex& a = lines[lineCount++];
+            sf::Vertex& b = lines[lineCount++];
+            a.position = previous;
+            a.color = color;
+            b.position = current;
+            b.color = color;
+            previous = current;
+        }
+    }
+
+    // Añade un cuadrado de lado 2*halfSize centrado en 'position'
+    void addQuad(const sf::Vector2f& position, float halfSize, sf::Color color) {
+        ensure(quads, quadCount + 4);
+        sf::Vertex* v = &quads[quadCount];
+        v[0].position = { position.x - halfSize, position.y - halfSize };
+        v[1].position = { position.x + halfSize, position.y - halfSize };
+        v[2].position = { position.x + halfSize, position.y + halfSize };
+        v[3].position = { position.x - halfSize, position.y + halfSize };
+        for (int i = 0; i < 4; ++i) {
+            v[i].color = color;
+        }
+        quadCount += 4;
+    }
+
+    // Añade todas las partículas vivas, con la opacidad según la vida que les
+    // queda. El buffer se dimensiona una vez para el pool entero.
+    void addParticles(const ParticleSystem& particles) {
+        const ParticleArrays& p = particles.arrays;
+        const size_t n = p.size();
+        ensure(particleQuads, std::max(particleCount + n * 4, particles.capacity() * 4));
+        sf::Vertex* v = &particleQuads[particleCount];
+        const float h = PARTICLE_HALF_SIZE;
+        for (size_t i = 0; i < n; ++i, v += 4) {
+            const std::uint32_t rgb = p.color[i];
+            const sf::Color color(static_cast<sf::Uint8>(rgb >> 24), static_cast<sf::Uint8>(rgb >> 16),
+                                  static_cast<sf::Uint8>(rgb >> 8), static_cast<sf::Uint8>(p.opacity(i) * 255.0f));
+            const float x = p.x[i];
+            const float y = p.y[i];
+            v[0].position = { x - h, y - h };
+            v[1].position = { x + h, y - h };
+            v[2].position = { x + h, y + h };
+            v[3].position = { x - h, y + h };
+            v[0].color = color;
+            v[1].color = color;
+            v[2].color = color;
+            v[3].color = color;
+        }
+        particleCount += n * 4;
+    }
+
+    // Envía los buffers acumulados: como máximo una draw call por buffer. Las
+    // partículas van primero, por debajo de todo lo demás.
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default) {
+        if (particleCount > 0) {
+            target.draw(&particleQuads[0], particleCount, sf::Quads, states);
+            ++drawCalls;
+        }
+        if (lineCount > 0) {
+            target.draw(&lines[0], lineCount, sf::Lines, states);
+            ++drawCalls;
+        }
+        if (quadCount > 0) {
+            target.draw(&quads[0], quadCount, sf::Quads, states);
+            ++drawCalls;
+        }
+        lineCount = 0;
+        quadCount = 0;
+        particleCount = 0;
+    }
+
+    size_t getDrawCalls() const { return drawCalls; }
+
+private:
+    static sf::Vector2f transform(const sf::Vector2f& p, const sf::Vector2f& position, float c, float s) {
+        return { position.x + p.x * c - p.y * s, position.y + p.x * s + p.y * c };
+    }
+
+    static void ensure(sf::VertexArray& array, size_t needed) {
+        if (needed > array.getVertexCount()) {
+            array.resize(std::max(needed, array.getVertexCount() * 2));
+        }
+    }
+
+    sf::VertexArray lines;
+    sf::VertexArray quads;
+    sf::VertexArray particleQuads;
+    size_t lineCount;
+    size_t quadCount;
+    size_t particleCount;
+    size_t drawCalls;
+};
@@ -0,0 +1,707 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "GameConfig.hpp"
+#include "AngleMath.hpp"
+#include "CollisionDriver.hpp"
+#include "EntityArrays.hpp"
+#include "EntityPool.hpp"
+#include "JobSystem.hpp"
+#include "LinearArena.hpp"
+#include "Profiler.hpp"
+#include "SpatialGrid.hpp"
+
+// Bits de entrada de un tick (muestreados del teclado o de un guion)
+enum InputBits : std::uint8_t {
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_THRUST = 1 << 2,
+    INPUT_FIRE = 1 << 3
+};
+
+// Límites de rebote de los asteroides y de la nave en un mundo de
+// width x height (ya descontado el medio tamaño)
+constexpr BounceBounds asteroidBoundsFor(float width, float height) {
+    return { ASTEROID_W / 2.0f, width - ASTEROID_W / 2.0f, ASTEROID_H / 2.0f, height - ASTEROID_H / 2.0f };
+}
+
+constexpr BounceBounds playerBoundsFor(float width, float height) {
+    return { PLAYER_W / 2.0f, width - PLAYER_W / 2.0f, PLAYER_H / 2.0f, height - PLAYER_H / 2.0f };
+}
+
+// Los del mundo por defecto, del tamaño de la ventana
+constexpr BounceBounds ASTEROID_BOUNDS = asteroidBoundsFor(SCREEN_WIDTH, SCREEN_HEIGHT);
+constexpr BounceBounds PLAYER_BOUNDS = playerBoundsFor(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+// Si el punto está dentro de los límites (bordes incluidos)
+inline bool insideBounds(const BounceBounds& bounds, float x, float y) {
+    // Con & y no con &&: sin ramas, que en recorridos largos fallan mucho
+    return (x >= bounds.minX) & (x <= bounds.maxX) & (y >= bounds.minY) & (y <= bounds.maxY);
+}
+
+// Rectángulo de medio lado halfSize centrado en 'center'
+inline BounceBounds boundsAround(const sf::Vector2f& center, const sf::Vector2f& halfSize) {
+    return { center.x - halfSize.x, center.x + halfSize.x, center.y - halfSize.y, center.y + halfSize.y };
+}
+
+// Centro de la cámara que sigue a 'target' sin enseñar nada fuera de un
+// mundo de worldSize (si el mundo es más pequeño que la ventana, su centro)
+inline sf::Vector2f cameraCenter(const sf::Vector2f& target, const sf::Vector2f& worldSize) {
+    auto axis = [](float value, float world, float view) {
+        return world <= view ? world / 2.0f : std::min(std::max(value, view / 2.0f), world - view / 2.0f);
+    };
+    return { axis(target.x, worldSize.x, SCREEN_WIDTH), axis(target.y, worldSize.y, SCREEN_HEIGHT) };
+}
+
+// Dirección con la que se movió el asteroide i en el último tick.
+// integrateAsteroids solo invierte un eje si el asteroide ha acabado fuera
+// de los límites en ese eje, así que se deduce de la posición final.
+inline sf::Vector2f asteroidTickDirection(const AsteroidArrays& a, size_t i,
+                                          const BounceBounds& bounds = ASTEROID_BOUNDS) {
+    bool bouncedX = a.x[i] <= bounds.minX || a.x[i] >= bounds.maxX;
+    bool bouncedY = a.y[i] <= bounds.minY || a.y[i] >= bounds.maxY;
+    return { bouncedX ? -a.dx[i] : a.dx[i], bouncedY ? -a.dy[i] : a.dy[i] };
+}
+
+// Distancia máxima entre dos pruebas de casco contra casco al barrer el
+// movimiento de un tick (menos que lo más estrecho de la nave)
+constexpr float HULL_SWEEP_STEP = 8.0f;
+
+// Medio lado del cuadrado alrededor de la nave donde los asteroides avanzan
+// en cada tick y entran en las colisiones. Ninguna bala llega más lejos (la
+// bala y la nave se alejan como mucho a la suma de sus velocidades durante
+// la vida de la bala) y sobra un asteroide entero, así que fuera de él no
+// puede haber choques.
+constexpr float SIM_ACTIVE_RANGE = (BULLET_SPEED + PLAYER_SPEED) * BULLET_LIFE + ASTEROID_W;
+
+// Cascos de colisión (descomposición convexa calculada una sola vez)
+inline const CollisionHull& asteroidCollisionHull() {
+    static const CollisionHull hull(ASTEROID_HULL, 11);
+    return hull;
+}
+
+inline const CollisionHull& playerCollisionHull() {
+    static const CollisionHull hull(PLAYER_HULL, 4);
+    return hull;
+}
+
+// Generación aleatoria a partir de un generador explícito. Se usan los bits
+// del generador directamente: las distribuciones de la biblioteca estándar
+// pueden dar otros valores con otro compilador.
+inline float randomRange(std::mt19937& gen, float min, float max) {
+    return min + (max - min) * (static_cast<float>(gen() >> 8) * (1.0f / 16777216.0f));
+}
+
+inline sf::Vector2f randomAsteroidDirection(std::mt19937& gen) {
+    return angleDirection(static_cast<BinaryAngle>(gen()));
+}
+
+inline sf::Vector2f randomAsteroidPosition(std::mt19937& gen, float width = SCREEN_WIDTH, float height = SCREEN_HEIGHT) {
+    float x = randomRange(gen, ASTEROID_W / 2.0f, width - ASTEROID_W / 2.0f);
+    return sf::Vector2f(x, randomRange(gen, ASTEROID_W / 2.0f, height - ASTEROID_H / 2.0f));
+}
+
+// Estado de la nave
+struct PlayerState {
+    sf::Vector2f position{ SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+    BinaryAngle angle = 0;
+    float shootTimer = 0.0f;
+};
+
+// Lo que ha pasado en el último tick (para sonido y efectos de la ventana)
+struct TickEvents {
+    int shots = 0;
+    int kills = 0;
+};
+
+// Entidades por trozo de trabajo. Es fijo (no depende del número de hilos)
+// para que el reparto, y por tanto el resultado, sea siempre el mismo.
+constexpr size_t SIM_CHUNK_SIZE = 4096;
+
+// Contacto de una bala con un asteroide durante el tick (índices densos)
+struct Impact {
+    float time;  // 0..1 dentro del tick
+    std::uint32_t bullet;
+    std::uint32_t asteroid;
+};
+
+// Órdenes que genera un trozo de trabajo durante el tick. Cada trozo escribe
+// solo en su buffer y al final se aplican en orden de trozo.
+struct CommandBuffer {
+    std::vector<EntityHandle> bulletKills;
+    std::vector<EntityHandle> asteroidKills;
+    std::vector<Impact> impacts;
+    CollisionStats stats;
+
+    void clear() {
+        bulletKills.clear();
+        asteroidKills.clear();
+        impacts.clear();
+        stats.reset();
+    }
+};
+
+// Bala pendiente de crear al final del tick
+struct BulletSpawn {
+    sf::Vector2f position;
+    sf::Vector2f direction;
+};
+
+// Nave y disparos de un tick: gira, acelera (sin salir de 'bounds') y, si
+// toca, deja una bala pendiente en 'spawns'. Compartido por todos los mundos.
+inline void advancePlayer(PlayerState& player, std::uint8_t input, float dt,
+                          std::vector<BulletSpawn>& spawns, TickEvents& events,
+                          const BounceBounds& bounds = PLAYER_BOUNDS) {
+    player.shootTimer -= dt;
+
+    if (input & INPUT_LEFT) {
+        player.angle -= angleFromDegrees(TURN_SPEED * dt);
+    }
+    if (input & INPUT_RIGHT) {
+        player.angle += angleFromDegrees(TURN_SPEED * dt);
+    }
+    if (input & INPUT_THRUST) {
+        sf::Vector2f heading = angleDirection(player.angle);
+        player.position.x += heading.x * PLAYER_SPEED * dt;
+        player.position.y += heading.y * PLAYER_SPEED * dt;
+
+        player.position.x = std::min(std::max(player.position.x, bounds.minX), bounds.maxX);
+        player.position.y = std::min(std::max(player.position.y, bounds.minY), bounds.maxY);
+    }
+    if ((input & INPUT_FIRE) && player.shootTimer <= 0.0f) {
+        player.shootTimer = SHOOT_DELAY;
+        spawns.push_back({ player.position, angleDirection(player.angle) });
+        ++events.shots;
+    }
+}
+
+// Colisión continua de un tick: todo se prueba sobre el movimiento del tick
+// (posición inicial = final - desplazamiento). Los círculos envolventes
+// barridos dan el intervalo en que puede haber contacto y descartan casi
+// todos los pares; en ese intervalo se prueba el casco exacto a pasos cortos.
+// Compartido por todos los mundos con balas, asteroides y naves.
+struct TickSweep {
+    explicit TickSweep(float dt, const BounceBounds& asteroidBounds = ASTEROID_BOUNDS)
+        : asteroidHull(asteroidCollisionHull()),
+          playerHull(playerCollisionHull()),
+          asteroidRadius(asteroidHull.getBoundingRadius()),
+          playerRadius(playerHull.getBoundingRadius()),
+          bulletStep(BULLET_SPEED * dt),
+          asteroidStep(ASTEROID_SPEED * dt),
+          asteroidTurn(static_cast<std::int32_t>(angleFromDegrees(ASTEROID_SPIN * dt))),
+          asteroidArc(asteroidRadius * turnToRadians(asteroidTurn)),
+          asteroidBounds(asteroidBounds) {}
+
+    // Zona de la rejilla que hay que mirar para la bala b
+    sf::Vector2f bulletCenter(const BulletArrays& b, size_t i) const {
+        return { b.x[i] - b.dx[i] * bulletStep * 0.5f, b.y[i] - b.dy[i] * bulletStep * 0.5f };
+    }
+    float bulletReach() const {
+        return BULLET_RADIUS + asteroidRadius + bulletStep * 0.5f + asteroidStep;
+    }
+
+    // Primer instante (0..1) en que la bala b toca el asteroide a, o -1
+    float bulletAsteroid(const BulletArrays& b, size_t bi, const AsteroidArrays& a, size_t ai) const {
+        sf::Vector2f bulletMotion(b.dx[bi] * bulletStep, b.dy[bi] * bulletStep);
+        sf::Vector2f bulletStart = b.position(bi) - bulletMotion;
+        sf::Vector2f asteroidMotion = asteroidTickDirection(a, ai, asteroidBounds) * asteroidStep;
+        sf::Vector2f asteroidStart = a.position(ai) - asteroidMotion;
+        sf::Vector2f relative = asteroidMotion - bulletMotion;
+        float enter, exit;
+        if (!sweptCircleInterval(asteroidStart - bulletStart, relative, BULLET_RADIUS + asteroidRadius, enter, exit)) {
+            return -1.0f;
+        }
+        BinaryAngle endAngle = a.angle[ai];
+        int samples = sweepSamples(enter, exit, length(relative) + asteroidArc, BULLET_RADIUS);
+        return firstContactTime(enter, exit, samples, [&](float t) {
+            HullPose pose = HullPose::fromAngle(asteroidStart + asteroidMotion * t, endAngle - scaleTurn(asteroidTurn, 1.0f - t));
+            return circleHullIntersect(bulletStart + bulletMotion * t, BULLET_RADIUS, asteroidHull, pose);
+        });
+    }
+
+    // Zona de la rejilla que hay que mirar para una nave que ha ido de
+    // 'before' a 'after'
+    sf::Vector2f shipCenter(const PlayerState& before, const PlayerState& after) const {
+        return (before.position + after.position) * 0.5f;
+    }
+    float shipReach(const PlayerState& before, const PlayerState& after) const {
+        return playerRadius + asteroidRadius + length(after.position - before.position) * 0.5f + asteroidStep;
+    }
+
+    // Primer instante (0..1) en que la nave toca el asteroide a, o -1
+    float shipAsteroid(const PlayerState& before, const PlayerState& after, const AsteroidArrays& a, size_t ai) const {
+        sf::Vector2f shipMotion = after.position - before.position;
+        std::int32_t shipTurn = angleDelta(before.angle, after.angle);
+        float shipArc = playerRadius * std::fabs(turnToRadians(shipTurn));
+        sf::Vector2f asteroidMotion = asteroidTickDirection(a, ai, asteroidBounds) * asteroidStep;
+        sf::Vector2f asteroidStart = a.position(ai) - asteroidMotion;
+        sf::Vector2f relative = asteroidMotion - shipMotion;
+        float enter, exit;
+        if (!sweptCircleInterval(asteroidStart - before.position, relative, playerRadius + asteroidRadius, enter, exit)) {
+            return -1.0f;
+        }
+        BinaryAngle endAngle = a.angle[ai];
+        int samples = sweepSamples(enter, exit, length(relative) + asteroidArc + shipArc, HULL_SWEEP_STEP);
+        return firstContactTime(enter, exit, samples, [&](float t) {
+            HullPose shipPose = HullPose::fromAngle(before.position + shipMotion * t, before.angle + scaleTurn(shipTurn, t));
+            HullPose asteroidPose = HullPose::fromAngle(asteroidStart + asteroidMotion * t,
+                                                        endAngle - scaleTurn(asteroidTurn, 1.0f - t));
+            return hullsIntersect(playerHull, shipPose, asteroidHull, asteroidPose);
+        });
+    }
+
+    const CollisionHull& asteroidHull;
+    const CollisionHull& playerHull;
+    float asteroidRadius;
+    float playerRadius;
+    float bulletStep;
+    float asteroidStep;
+    std::int32_t asteroidTurn;  // Giro binario de un asteroide en un tick
+    float asteroidArc;
+    BounceBounds asteroidBounds;
+
+private:
+    static float length(const sf::Vector2f& v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+};
+
+// Parámetros de una partida
+struct SimConfig {
+    float asteroidSpawnTime = ASTEROID_SPAWN_TIME;
+    std::uint32_t initialAsteroids = 0;
+    std::uint32_t maxBullets = MAX_BULLETS;
+    std::uint32_t maxAsteroids = MAX_ASTEROIDS;
+    bool invulnerable = false;  // Para pruebas de carga: chocar no acaba la partida
+    // Tamaño del mundo (por defecto, el de la ventana)
+    float worldWidth = SCREEN_WIDTH;
+    float worldHeight = SCREEN_HEIGHT;
+    // Los asteroides a más de SIM_ACTIVE_RANGE de la nave avanzan solo en uno
+    // de cada farTickInterval ticks, con el tiempo de todos ellos (1: todos
+    // en cada tick). Allí no hay colisiones, así que solo cambia el detalle
+    // del movimiento de lo que nadie ve. Potencia de dos, para repartir los
+    // ticks con una máscara.
+    std::uint32_t farTickInterval = 1;
+};
+
+// Estado de una partida que no está en los pools. Vive en la arena de la
+// Simulation y se rehace en cada reinicio.
+struct SimSession {
+    PlayerState player;
+    int score = 0;
+    bool gameOver = false;
+    std::uint64_t tick = 0;
+    float asteroidSpawnTime = 0.0f;
+};
+
+// Foto del estado de una partida (Simulation::save/restore)
+using SimCheckpoint = ArenaSnapshot;
+
+// Núcleo de la simulación, sin ventana ni reloj: generación de asteroides,
+// movimiento, colisiones, altas/bajas y puntaje. Con la misma semilla y la
+// misma secuencia de entradas produce siempre el mismo resultado, con o sin
+// JobSystem y con cualquier número de hilos.
+//
+// Las colisiones son continuas: se barre el movimiento de todo el tick, así
+// que una bala no atraviesa un asteroide aunque dt sea grande (30 Hz o
+// menos). Si una bala toca varios asteroides, o un asteroide varias balas,
+// gana el primer contacto en el tiempo.
+//
+// Todo el estado de la partida (pools, nave, puntaje, tick) y el generador
+// aleatorio viven en una sola LinearArena reservada al crear el mundo:
+// reiniciar es volver a la marca de la partida y repartirla otra vez, y una
+// foto es una copia de la arena (save/restore). Lo demás son buffers de
+// trabajo que se vacían en cada tick.
+class Simulation {
+    // La arena va la primera: los miembros de abajo apuntan a sus trozos. La
+    // partida se reparte siempre igual desde sessionStart, así que 'session'
+    // (y las referencias públicas a sus campos) no cambian de dirección.
+    LinearArena arena;
+    std::mt19937& rng;  // Antes de la marca: sigue entre reinicios
+    std::size_t sessionStart;
+    SimSession* session;
+
+public:
+    explicit Simulation(std::uint32_t seed, const SimConfig& config = SimConfig(), JobSystem* jobs = nullptr)
+        : arena(arenaBytes(config)),
+          rng(*arena.create<std::mt19937>()),
+          sessionStart(arena.mark()),
+          session(arena.create<SimSession>()),
+          player(session->player),
+          score(session->score),
+          gameOver(session->gameOver),
+          tick(session->tick),
+          config(config),
+          jobs(jobs),
+          asteroidArea(asteroidBoundsFor(config.worldWidth, config.worldHeight)),
+          playerArea(playerBoundsFor(config.worldWidth, config.worldHeight)),
+          grid(ASTEROID_W, config.worldWidth, config.worldHeight) {
+        // Las reservas no pasan de la capacidad de los pools, para que un
+        // mundo pequeño (WorldBatch) ocupe poco
+        size_t maxChunks = chunkCount(config.maxBullets) + chunkCount(config.maxAsteroids);
+        size_t chunkReserve = std::min<size_t>(SIM_CHUNK_SIZE, std::max(config.maxBullets, config.maxAsteroids));
+        commands.resize(maxChunks);
+        for (auto& buffer : commands) {
+            buffer.bulletKills.reserve(chunkReserve);
+            buffer.asteroidKills.reserve(chunkReserve);
+            buffer.impacts.reserve(64);
+        }
+        impacts.reserve(256);
+        relocated.reserve(chunkReserve);
+        workerScratch.resize(jobs ? jobs->size() : 1);
+        for (auto& scratch : workerScratch) {
+            scratch.reserve(std::min<size_t>(SIM_CHUNK_SIZE, config.maxBullets));
+        }
+        bulletSpawns.reserve(16);
+        explosions.reserve(64);
+        grid.reserve(config.maxAsteroids);
+        reset(seed);
+    }
+
+    // Nueva partida con otra semilla
+    void reset(std::uint32_t seed) {
+        rng.seed(seed);
+        restart();
+    }
+
+    // Nueva partida continuando la secuencia aleatoria actual. Cuesta lo
+    // mismo con cualquier capacidad: no se recorre nada, salvo para crear
+    // los asteroides iniciales.
+    void restart() {
+        arena.reset(sessionStart);
+        session = arena.create<SimSession>();
+        session->player.position = { config.worldWidth / 2, config.worldHeight / 2 };
+        session->asteroidSpawnTime = config.asteroidSpawnTime;
+        bullets.bind(arena, config.maxBullets);
+        asteroids.bind(arena, config.maxAsteroids);
+        events = TickEvents();
+        explosions.clear();
+        for (std::uint32_t i = 0; i < config.initialAsteroids; i++) {
+            spawnAsteroid();
+        }
+        gridStale = true;
+    }
+
+    // Copia el estado de la partida (la arena entera) en 'out'. La foto sirve
+    // para este mundo o para cualquier otro con la misma configuración: para
+    // volver atrás o para lanzar muchas partidas desde el mismo punto.
+    void save(SimCheckpoint& out) const {
+        arena.save(out);
+    }
+
+    // Vuelve al estado de una foto (false si es de otra configuración)
+    bool restore(const SimCheckpoint& in) {
+        if (!arena.restore(in)) {
+            return false;
+        }
+        events = TickEvents();
+        explosions.clear();
+        gridStale = true;
+        return true;
+    }
+
+    // Mide las fases de cada tick en este profiler (nulo: sin medición)
+    void setProfiler(Profiler* value) {
+        profiler = value;
+    }
+
+    // Avanza un tick de duración dt con la entrada indicada
+    void step(std::uint8_t input, float dt) {
+        events = TickEvents();
+        explosions.clear();
+        if (gameOver) {
+            return;
+        }
+        ++tick;
+
+        // Lógica de generación de asteroides
+        {
+            ProfileScope scope(profiler, ProfilePhase::Spawn);
+            session->asteroidSpawnTime -= dt;
+            if (session->asteroidSpawnTime <= 0.0f) {
+                session->asteroidSpawnTime = config.asteroidSpawnTime;
+                spawnAsteroid();
+            }
+        }
+
+        // Actualización de las entidades, repartida en trozos
+        const size_t bulletChunks = chunkCount(bullets.size());
+        const size_t asteroidChunks = chunkCount(asteroids.size());
+        integrate(bulletChunks, asteroidChunks, dt);
+        PlayerState previousPlayer = player;
+        {
+            ProfileScope scope(profiler, ProfilePhase::Player);
+            advancePlayer(player, input, dt, bulletSpawns, events, playerArea);
+        }
+
+        detectCollisions(bulletChunks, previousPlayer, dt);
+        applyCommands();
+    }
+
+    // Llama a fn(i) por cada asteroide (índice denso) con el centro dentro de
+    // 'area', mirando solo las celdas de la rejilla que la tocan: cuesta lo
+    // que haya cerca, no lo que haya en el mundo. 'area' debe quedar dentro
+    // de SIM_ACTIVE_RANGE de la nave, donde la rejilla lo tiene todo.
+    //
+    // La rejilla es la del último tick: las bajas de después han movido
+    // asteroides de sitio en los arrays (swap-remove), así que los índices
+    // que han cambiado se saltan en la rejilla y se miran aparte.
+    template <typename Fn>
+    void queryAsteroids(const BounceBounds& area, Fn&& fn) const {
+        const AsteroidArrays& a = asteroids.arrays;
+        const std::uint32_t count = static_cast<std::uint32_t>(a.size());
+        if (gridStale) {
+            for (std::uint32_t i = 0; i < count; i++) {
+                if (insideBounds(area, a.x[i], a.y[i])) {
+                    fn(i);
+                }
+            }
+            return;
+        }
+        grid.queryRect(area.minX, area.minY, area.maxX, area.maxY, [&](std::uint32_t i) {
+            if (i < count && insideBounds(area, a.x[i], a.y[i])
+                && !std::binary_search(relocated.begin(), relocated.end(), i)) {
+                fn(i);
+            }
+        });
+        for (std::uint32_t i : relocated) {
+            if (i < count && insideBounds(area, a.x[i], a.y[i])) {
+                fn(i);
+            }
+        }
+    }
+
+    sf::Vector2f worldSize() const { return { config.worldWidth, config.worldHeight }; }
+    const BounceBounds& asteroidBounds() const { return asteroidArea; }
+
+    // Estado visible (en la arena)
+    PlayerState& player;
+    EntityPool<BulletArrays> bullets;
+    EntityPool<AsteroidArrays> asteroids;
+    int& score;
+    bool& gameOver;
+    std::uint64_t& tick;
+    TickEvents events;
+    std::vector<sf::Vector2f> explosions;  // Dónde se destruyó cada asteroide del último tick
+    CollisionStats stats;
+
+private:
+    // Lo que ocupa la arena: generador aleatorio, partida y pools
+    static std::size_t arenaBytes(const SimConfig& config) {
+        return LinearArena::bytesFor<std::mt19937>(1) + LinearArena::bytesFor<SimSession>(1)
+             + EntityPool<BulletArrays>::arenaBytes(config.maxBullets)
+             + EntityPool<AsteroidArrays>::arenaBytes(config.maxAsteroids);
+    }
+
+    static size_t chunkCount(size_t count) {
+        return (count + SIM_CHUNK_SIZE - 1) / SIM_CHUNK_SIZE;
+    }
+
+    void integrate(size_t bulletChunks, size_t asteroidChunks, float dt) {
+        ProfileScope scope(profiler, ProfilePhase::Integrate);
+        forEachChunk(bulletChunks + asteroidChunks, [&](size_t chunk, unsigned worker) {
+            if (chunk < bulletChunks) {
+                size_t begin = chunk * SIM_CHUNK_SIZE;
+                integrateBullets(bullets.arrays, BULLET_SPEED, dt, begin, begin + SIM_CHUNK_SIZE);
+
+                std::vector<std::uint32_t>& expired = workerScratch[worker];
+                collectExpiredBullets(bullets.arrays, expired, begin, begin + SIM_CHUNK_SIZE);
+                for (std::uint32_t b : expired) {
+                    commands[chunk].bulletKills.push_back(bullets.handleAt(b));
+                }
+                expired.clear();
+            } else {
+                size_t begin = (chunk - bulletChunks) * SIM_CHUNK_SIZE;
+                if (config.farTickInterval > 1) {
+                    // Los de lejos, solo cuando les toca (según su slot, para
+                    // repartir el trabajo entre ticks)
+                    integrateAsteroidsStaggered(asteroids.arrays, asteroids.denseSlots(), activeArea(),
+                                                config.farTickInterval, static_cast<std::uint32_t>(tick) & (config.farTickInterval - 1),
+                                                ASTEROID_SPEED * dt, angleFromDegrees(ASTEROID_SPIN * dt), asteroidArea,
+                                                begin, begin + SIM_CHUNK_SIZE);
+                } else {
+                    integrateAsteroids(asteroids.arrays, ASTEROID_SPEED, ASTEROID_SPIN, asteroidArea, dt,
+                                       begin, begin + SIM_CHUNK_SIZE);
+                }
+            }
+        });
+    }
+
+    // Zona donde los asteroides avanzan en cada tick y colisionan
+    BounceBounds activeArea() const {
+        return boundsAround(player.position, { SIM_ACTIVE_RANGE, SIM_ACTIVE_RANGE });
+    }
+
+    // Aplicar las órdenes en orden de trozo: primero bajas (O(1) cada una;
+    // las repetidas se ignoran) y después altas
+    void applyCommands() {
+        ProfileScope scope(profiler, ProfilePhase::Apply);
+        auto apply = [this](CommandBuffer& buffer) {
+            for (auto& handle : buffer.bulletKills) {
+                bullets.kill(handle);
+            }
+            for (auto& handle : buffer.asteroidKills) {
+                if (asteroids.alive(handle)) {
+                    std::uint32_t index = static_cast<std::uint32_t>(asteroids.indexOf(handle));
+                    explosions.push_back(asteroids.arrays.position(index));
+                    relocated.push_back(index);
+                    asteroids.kill(handle);
+                    score += 20; // Incrementar puntaje al destruir un asteroide
+                    ++events.kills;
+                }
+            }
+            stats.pairsTested += buffer.stats.pairsTested;
+            stats.pairsHit += buffer.stats.pairsHit;
+            buffer.clear();
+        };
+        for (auto& buffer : commands) {
+            apply(buffer);
+        }
+        apply(impactKills);
+        for (auto& spawn : bulletSpawns) {
+            bullets.spawn(spawn.position, spawn.direction, BULLET_LIFE);
+        }
+        bulletSpawns.clear();
+        std::sort(relocated.begin(), relocated.end());
+        relocated.erase(std::unique(relocated.begin(), relocated.end()), relocated.end());
+    }
+
+    // Ejecuta fn(chunk, worker) en paralelo si hay JobSystem, en orden si no
+    template <typename Fn>
+    void forEachChunk(size_t chunks, Fn&& fn) {
+        if (jobs) {
+            jobs->parallelFor(chunks, fn);
+        } else {
+            for (size_t c = 0; c < chunks; ++c) {
+                fn(c, 0u);
+            }
+        }
+    }
+
+    void spawnAsteroid() {
+        sf::Vector2f position = randomAsteroidPosition(rng, config.worldWidth, config.worldHeight);
+        asteroids.spawn(position, randomAsteroidDirection(rng));
+    }
+
+    void detectCollisions(size_t bulletChunks, const PlayerState& previousPlayer, float dt) {
+        // Meter los asteroides en la rejilla (con farTickInterval, solo los
+        // de la zona activa: los demás ni se mueven este tick ni pueden chocar)
+        {
+            ProfileScope scope(profiler, ProfilePhase::Broadphase);
+            const AsteroidArrays& a = asteroids.arrays;
+            const BounceBounds active = activeArea();
+            const bool everywhere = config.farTickInterval <= 1;
+            grid.clear();
+            for (size_t i = 0; i < asteroids.size(); i++) {
+                if (everywhere || insideBounds(active, a.x[i], a.y[i])) {
+                    grid.insert(static_cast<std::uint32_t>(i), a.position(i));
+                }
+            }
+            grid.build();
+            relocated.clear();
+            gridStale = false;
+        }
+        ProfileScope scope(profiler, ProfilePhase::Narrowphase);
+        const TickSweep sweep(dt, asteroidArea);
+
+        // Balas contra asteroides (solo celdas vecinas), repartido en trozos.
+        // Cada trozo apunta los contactos con su instante; se resuelven
+        // después, en orden de tiempo.
+        forEachChunk(bulletChunks, [&](size_t chunk, unsigned) {
+            CommandBuffer& buffer = commands[chunk];
+            size_t end = std::min((chunk + 1) * SIM_CHUNK_SIZE, bullets.size());
+            for (size_t b = chunk * SIM_CHUNK_SIZE; b < end; b++) {
+                grid.query(sweep.bulletCenter(bullets.arrays, b), sweep.bulletReach(), [&](std::uint32_t a) {
+                    ++buffer.stats.pairsTested;
+                    float time = sweep.bulletAsteroid(bullets.arrays, b, asteroids.arrays, a);
+                    if (time >= 0.0f) {
+                        ++buffer.stats.pairsHit;
+                        buffer.impacts.push_back({ time, static_cast<std::uint32_t>(b), a });
+                    }
+                });
+            }
+        });
+        resolveImpacts(bulletChunks);
+
+        // Jugador contra asteroides (casco contra casco)
+        grid.query(sweep.shipCenter(previousPlayer, player), sweep.shipReach(previousPlayer, player), [&](std::uint32_t a) {
+            ++stats.pairsTested;
+            if (sweep.shipAsteroid(previousPlayer, player, asteroids.arrays, a) >= 0.0f) {
+                ++stats.pairsHit;
+                if (!config.invulnerable) {
+                    gameOver = true;  // El juego ha terminado
+                }
+            }
+        });
+    }
+
+    // Junta los contactos de todos los trozos y los recorre por orden de
+    // tiempo (y de índices, para desempatar siempre igual): cada bala
+    // destruye el primer asteroide que toca, y un asteroide ya destruido
+    // no para más balas.
+    void resolveImpacts(size_t bulletChunks) {
+        impacts.clear();
+        for (size_t c = 0; c < bulletChunks; ++c) {
+            impacts.insert(impacts.end(), commands[c].impacts.begin(), commands[c].impacts.end());
+        }
+        if (impacts.empty()) {
+            return;
+        }
+        std::sort(impacts.begin(), impacts.end(), [](const Impact& a, const Impact& b) {
+            if (a.time != b.time) return a.time < b.time;
+            if (a.bullet != b.bullet) return a.bullet < b.bullet;
+            return a.asteroid < b.asteroid;
+        });
+        bulletHit.assign(bullets.size(), 0);
+        asteroidHit.assign(asteroids.size(), 0);
+        for (const Impact& impact : impacts) {
+            if (bulletHit[impact.bullet] || asteroidHit[impact.asteroid]) {
+                continue;
+            }
+            bulletHit[impact.bullet] = 1;
+            asteroidHit[impact.asteroid] = 1;
+            impactKills.bulletKills.push_back(bullets.handleAt(impact.bullet));
+            impactKills.asteroidKills.push_back(asteroids.handleAt(impact.asteroid));
+        }
+    }
+
+    SimConfig config;
+    JobSystem* jobs;
+    Profiler* profiler = nullptr;
+    BounceBounds asteroidArea;
+    BounceBounds playerArea;
+    SpatialGrid grid;
+    bool gridStale = true;                 // La rejilla no es del estado actual (reinicio o foto)
+    std::vector<std::uint32_t> relocated;  // Índices que han cambiado de asteroide desde la rejilla
+    std::vector<CommandBuffer> commands;
+    std::vector<std::vector<std::uint32_t>> workerScratch;
+    std::vector<BulletSpawn> bulletSpawns;
+    std::vector<Impact> impacts;
+    std::vector<std::uint8_t> bulletHit;
+    std::vector<std::uint8_t> asteroidHit;
+    CommandBuffer impactKills;
+};
+
+// Entrada guionizada para ejecuciones sin teclado: gira, dispara y acelera
+// a ratos siguiendo un patrón fijo derivado del número de tick y una semilla.
+class ScriptedInput {
+public:
+    explicit ScriptedInput(std::uint32_t seed) : seed(seed) {}
+
+    std::uint8_t next(std::uint64_t tick) const {
+        std::uint32_t phase = static_cast<std::uint32_t>(tick / 90) ^ seed;
+        std::uint8_t input = INPUT_FIRE;
+        input |= (phase & 1) ? INPUT_LEFT : INPUT_RIGHT;
+        if ((phase >> 1) % 3 == 0) {
+            input |= INPUT_THRUST;
+        }
+        return input;
+    }
+
+private:
+    std::uint32_t seed;
+};
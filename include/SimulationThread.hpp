@@ -0,0 +1,328 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameConfig.hpp"
+#include "InputRecording.hpp"
+#include "Profiler.hpp"
+#include "Simulation.hpp"
+#include "TripleBuffer.hpp"
+
+// Posiciones de las últimas explosiones que guarda la foto
+constexpr std::size_t RENDER_EXPLOSION_HISTORY = 64;
+// Lo que se copia en la foto va más allá de la ventana: medio asteroide y lo
+// que se mueven la cámara y los asteroides durante la interpolación
+constexpr float RENDER_CULL_MARGIN = ASTEROID_W;
+
+// Foto inmutable de un tick para el render: el estado tras el tick y el de
+// justo antes, para poder interpolar entre ambos. Solo lleva las balas y los
+// asteroides cerca de la cámara. Los vectores se reutilizan de una foto a
+// otra.
+struct RenderSnapshot {
+    std::uint64_t tick = 0;
+    std::chrono::steady_clock::time_point publishedAt;
+    float dt = SIM_DT;
+    sf::Vector2f worldSize{ SCREEN_WIDTH, SCREEN_HEIGHT };
+
+    PlayerState player;
+    PlayerState previousPlayer;
+    std::vector<sf::Vector2f> bullets, previousBullets;
+    std::vector<sf::Vector2f> asteroids, previousAsteroids;
+    std::vector<BinaryAngle> asteroidAngles, previousAsteroidAngles;
+
+    int score = 0;
+    bool started = false;
+    bool gameOver = false;
+    bool replayFinished = false;  // La repetición no tiene más frames
+
+    // Acumulados desde el arranque; el render los compara con los últimos
+    // que vio para saber cuántos disparos y explosiones sonar
+    std::uint64_t shots = 0;
+    std::uint64_t kills = 0;
+    std::uint64_t pairsTested = 0;
+    // Dónde fue la baja k: explosions[k % RENDER_EXPLOSION_HISTORY] (solo
+    // las últimas RENDER_EXPLOSION_HISTORY)
+    std::array<sf::Vector2f, RENDER_EXPLOSION_HISTORY> explosions{};
+    std::uint8_t input = 0;  // Entrada del último tick (para la estela de la nave)
+
+    // Percentiles (ms) del profiler de la simulación, por fase y por tick
+    std::array<float, PROFILE_PHASE_COUNT> phaseP50{};
+    std::array<float, PROFILE_PHASE_COUNT> phaseP99{};
+    float tickP50 = 0.0f;
+    float tickP99 = 0.0f;
+
+    // Cuánto se ha avanzado (0..1) desde el tick anterior hasta este. El
+    // render va un tick por detrás de la simulación y llega a este estado
+    // justo cuando se publicaría el siguiente.
+    float alpha(std::chrono::steady_clock::time_point now) const {
+        float elapsed = std::chrono::duration<float>(now - publishedAt).count();
+        return std::min(std::max(elapsed / dt, 0.0f), 1.0f);
+    }
+};
+
+// Ejecuta la simulación en su propio hilo a paso fijo, independiente del
+// ritmo del render. El hilo de render le pasa la entrada y las órdenes
+// (empezar, reiniciar) con atómicos y recibe fotos por un triple buffer, así
+// que ninguno de los dos se bloquea esperando al otro. Cada tick junta la
+// entrada y las órdenes en un frame de sesión, que se puede grabar o tomar
+// de una grabación (InputRecording.hpp).
+//
+// World es Simulation o cualquier mundo con su mismo estado visible
+// (explosiones del tick incluidas), step/restart/setProfiler y la consulta
+// de asteroides por zona (por ejemplo, PhysicsSimulation).
+template <typename World = Simulation>
+class SimulationThread {
+public:
+    SimulationThread(std::uint32_t seed, const SimConfig& config = SimConfig(), JobSystem* jobs = nullptr,
+                     float dt = SIM_DT)
+        : sim(seed, config, jobs), dt(dt) {
+        sim.setProfiler(&profiler);
+    }
+
+    ~SimulationThread() {
+        stop();
+    }
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Dónde escribe el profiler de la simulación al pedir la exportación
+    void setProfilePaths(const std::string& csvPath, const std::string& tracePath) {
+        profileCsvPath = csvPath;
+        profileTracePath = tracePath;
+    }
+
+    // Graba cada frame de sesión (entrada y órdenes) en 'target', que no se
+    // debe leer hasta después de stop(). Llamar antes de start().
+    void recordTo(InputRecording& target) {
+        recorder.emplace(target);
+    }
+
+    // Toma los frames de una grabación en vez de la entrada en vivo. Sin
+    // límite de ritmo, los ticks van tan rápido como se puedan calcular.
+    // Llamar antes de start(); el hilo debe haberse creado con la semilla y
+    // la configuración de la grabación.
+    void replayFrom(const InputRecording& source, bool unthrottled = false) {
+        replay.emplace(source);
+        replayUnthrottled = unthrottled;
+    }
+
+    void start() {
+        running.store(true, std::memory_order_relaxed);
+        thread = std::thread(&SimulationThread::run, this);
+    }
+
+    void stop() {
+        running.store(false, std::memory_order_relaxed);
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    // Llamadas desde el hilo de render --------------------------------------
+    void setInput(std::uint8_t bits) { input.store(bits, std::memory_order_relaxed); }
+    void requestStart() { startRequested.store(true, std::memory_order_relaxed); }
+    void requestRestart() { restartRequested.store(true, std::memory_order_relaxed); }
+    void requestProfileExport() { exportRequested.store(true, std::memory_order_relaxed); }
+
+    // Pasa a la última foto publicada (true si es nueva)
+    bool acquireSnapshot() { return snapshots.acquire(); }
+    const RenderSnapshot& snapshot() const { return snapshots.readBuffer(); }
+
+    // Solo con el hilo parado ----------------------------------------------
+    const World& simulation() const { return sim; }
+    std::uint64_t ticksRun() const { return totalTicks; }
+    const InputReplay* replayResult() const { return replay ? &*replay : nullptr; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Si la simulación se retrasa más que esto, se da por perdido el retraso
+    // en vez de encadenar ticks para recuperarlo
+    static constexpr int MAX_LAG_TICKS = 8;
+    static constexpr int PERCENTILE_INTERVAL = 30;
+
+    void run() {
+        const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(dt));
+        auto nextTick = Clock::now();
+        publish(sim.player, false);
+        while (running.load(std::memory_order_relaxed)) {
+            bool fastReplay = replay && replayUnthrottled && !replay->done();
+            if (!fastReplay) {
+                nextTick += tickDuration;
+                auto now = Clock::now();
+                if (now - nextTick > tickDuration * MAX_LAG_TICKS) {
+                    nextTick = now;
+                }
+                std::this_thread::sleep_until(nextTick);
+            }
+
+            // Frame de sesión: de la grabación o de lo que pide el render
+            bool hasFrame = true;
+            std::uint8_t frame = 0;
+            if (replay) {
+                hasFrame = !replay->done();
+                frame = hasFrame ? replay->next() : 0;
+            } else {
+                frame = input.load(std::memory_order_relaxed);
+                if (startRequested.exchange(false, std::memory_order_relaxed)) {
+                    frame |= SESSION_START;
+                }
+                if (restartRequested.exchange(false, std::memory_order_relaxed)) {
+                    frame |= SESSION_RESTART;
+                }
+            }
+            // El resultado lo cuenta este hilo, que es el que escribe
+            if (exportRequested.exchange(false, std::memory_order_relaxed)) {
+                if (profiler.exportCsv(profileCsvPath) && profiler.exportTrace(profileTracePath)) {
+                    std::cout << "Profiler de la simulación exportado a " << profileCsvPath << " y "
+                              << profileTracePath << std::endl;
+                } else {
+                    std::cerr << "Error al exportar el profiler de la simulación" << std::endl;
+                }
+            }
+
+            bool stepped = hasFrame && applySessionControl(sim, started, frame);
+            PlayerState previousPlayer = sim.player;
+            lastInput = stepped ? frame & SESSION_INPUT_MASK : 0;
+            if (stepped) {
+                profiler.beginFrame();
+                std::uint64_t pairsBefore = sim.stats.pairsTested;
+                sim.step(frame & SESSION_INPUT_MASK, dt);
+                profiler.endFrame({ static_cast<std::uint32_t>(sim.bullets.size()),
+                                    static_cast<std::uint32_t>(sim.asteroids.size()),
+                                    sim.stats.pairsTested - pairsBefore });
+                shots += static_cast<std::uint64_t>(sim.events.shots);
+                for (const sf::Vector2f& position : sim.explosions) {
+                    explosions[kills++ % RENDER_EXPLOSION_HISTORY] = position;
+                }
+                ++totalTicks;
+                if (++percentileCountdown >= PERCENTILE_INTERVAL) {
+                    percentileCountdown = 0;
+                    updatePercentiles();
+                }
+            }
+            if (hasFrame && recorder) {
+                recorder->record(frame, sim);
+            }
+            if (hasFrame && replay) {
+                replay->verify(sim);
+            }
+            publish(previousPlayer, stepped);
+        }
+    }
+
+    // Copia el estado a la foto libre y la publica. La posición anterior se
+    // reconstruye del movimiento del tick: las balas van en línea recta y la
+    // dirección de los asteroides antes del rebote la da
+    // asteroidTickDirection. Si no hubo tick (pantalla de inicio, game
+    // over), la anterior es la actual.
+    //
+    // Solo se copia lo que cae en la ventana alrededor de la cámara (con
+    // margen); los asteroides salen de la rejilla de la simulación, así que
+    // la foto cuesta lo que se ve y no lo que hay en el mundo.
+    void publish(const PlayerState& previousPlayer, bool stepped) {
+        RenderSnapshot& snap = snapshots.writeBuffer();
+        snap.tick = sim.tick;
+        snap.dt = dt;
+        snap.worldSize = sim.worldSize();
+        snap.player = sim.player;
+        snap.previousPlayer = previousPlayer;
+        snap.score = sim.score;
+        snap.started = started;
+        snap.gameOver = sim.gameOver;
+        snap.replayFinished = replay && replay->done();
+        snap.shots = shots;
+        snap.kills = kills;
+        snap.explosions = explosions;
+        snap.input = lastInput;
+        snap.pairsTested = sim.stats.pairsTested;
+        snap.phaseP50 = phaseP50;
+        snap.phaseP99 = phaseP99;
+        snap.tickP50 = tickP50;
+        snap.tickP99 = tickP99;
+
+        const float margin = RENDER_CULL_MARGIN + (PLAYER_SPEED + ASTEROID_SPEED) * dt;
+        const BounceBounds view = boundsAround(cameraCenter(sim.player.position, snap.worldSize),
+                                               { SCREEN_WIDTH / 2 + margin, SCREEN_HEIGHT / 2 + margin });
+
+        const BulletArrays& b = sim.bullets.arrays;
+        const float bulletStep = stepped ? BULLET_SPEED * dt : 0.0f;
+        snap.bullets.clear();
+        snap.previousBullets.clear();
+        for (size_t i = 0; i < b.size(); i++) {
+            if (insideBounds(view, b.x[i], b.y[i])) {
+                snap.bullets.push_back({ b.x[i], b.y[i] });
+                snap.previousBullets.push_back({ b.x[i] - b.dx[i] * bulletStep, b.y[i] - b.dy[i] * bulletStep });
+            }
+        }
+
+        const AsteroidArrays& a = sim.asteroids.arrays;
+        const BounceBounds& bounds = sim.asteroidBounds();
+        const float asteroidStep = stepped ? ASTEROID_SPEED * dt : 0.0f;
+        const BinaryAngle turn = stepped ? angleFromDegrees(ASTEROID_SPIN * dt) : 0;
+        snap.asteroids.clear();
+        snap.previousAsteroids.clear();
+        snap.asteroidAngles.clear();
+        snap.previousAsteroidAngles.clear();
+        sim.queryAsteroids(view, [&](std::uint32_t i) {
+            snap.asteroids.push_back({ a.x[i], a.y[i] });
+            snap.previousAsteroids.push_back(snap.asteroids.back() - asteroidTickDirection(a, i, bounds) * asteroidStep);
+            snap.asteroidAngles.push_back(a.angle[i]);
+            snap.previousAsteroidAngles.push_back(a.angle[i] - turn);
+        });
+
+        snap.publishedAt = Clock::now();
+        snapshots.publish();
+    }
+
+    void updatePercentiles() {
+        for (size_t p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+            ProfilePhase phase = static_cast<ProfilePhase>(p);
+            phaseP50[p] = static_cast<float>(profiler.phasePercentile(phase, 0.5));
+            phaseP99[p] = static_cast<float>(profiler.phasePercentile(phase, 0.99));
+        }
+        tickP50 = static_cast<float>(profiler.framePercentile(0.5));
+        tickP99 = static_cast<float>(profiler.framePercentile(0.99));
+    }
+
+    // Estado del hilo de simulación
+    World sim;
+    float dt;
+    Profiler profiler;
+    bool started = false;
+    std::uint64_t shots = 0;
+    std::uint64_t kills = 0;
+    std::array<sf::Vector2f, RENDER_EXPLOSION_HISTORY> explosions{};
+    std::uint8_t lastInput = 0;
+    std::uint64_t totalTicks = 0;
+    int percentileCountdown = 0;
+    std::array<float, PROFILE_PHASE_COUNT> phaseP50{};
+    std::array<float, PROFILE_PHASE_COUNT> phaseP99{};
+    float tickP50 = 0.0f;
+    float tickP99 = 0.0f;
+    std::string profileCsvPath = "profile_sim.csv";
+    std::string profileTracePath = "profile_sim.json";
+    std::optional<InputRecorder> recorder;
+    std::optional<InputReplay> replay;
+    bool replayUnthrottled = false;
+
+    // Compartido con el hilo de render
+    std::atomic<bool> running{ false };
+    std::atomic<std::uint8_t> input{ 0 };
+    std::atomic<bool> startRequested{ false };
+    std::atomic<bool> restartRequested{ false };
+    std::atomic<bool> exportRequested{ false };
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::thread thread;
+};
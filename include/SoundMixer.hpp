@@ -0,0 +1,147 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AssetCache.hpp"
+#include "SpscQueue.hpp"
+
+using SoundId = std::uint16_t;
+
+// Cómo se comporta un efecto de sonido al pedirlo
+struct SoundSettings {
+    std::uint8_t priority = 0;  // mayor = más importante; puede robar voces de menor prioridad
+    unsigned maxPerFrame = 4;   // como mucho, cuántas veces arranca en un mismo update()
+    float volume = 100.0f;
+};
+
+// Contadores acumulados del mezclador
+struct MixerStats {
+    std::uint64_t started = 0;
+    std::uint64_t stolen = 0;   // voces cortadas para dejar sonar otra más importante
+    std::uint64_t dropped = 0;  // peticiones descartadas (límites o sin voz libre)
+};
+
+// Efectos de sonido con un número fijo de voces (sf::Sound) creadas al
+// principio, que comparten los buffers ya decodificados. El juego pide
+// sonidos con play(), que solo encola la petición en una cola sin bloqueos;
+// update() las atiende una vez por frame: aplica los límites por frame, busca
+// una voz libre y, si no hay, roba la de menor prioridad que lleve más tiempo
+// sonando. Así pueden solaparse muchas explosiones sin que se corten entre sí
+// ni se reserve memoria mientras se juega.
+//
+// play() y update() pueden llamarse desde hilos distintos (un productor y un
+// consumidor); addSound() solo al configurar, antes de pedir sonidos.
+class SoundMixer {
+public:
+    explicit SoundMixer(std::size_t voiceCount = 32, unsigned maxStartsPerFrame = 16)
+        : voices(voiceCount), maxStartsPerFrame(maxStartsPerFrame) {}
+
+    SoundId addSound(AssetHandle<sf::SoundBuffer> buffer, const SoundSettings& settings = SoundSettings()) {
+        sounds.push_back({ std::move(buffer), settings });
+        startsThisFrame.push_back(0);
+        return static_cast<SoundId>(sounds.size() - 1);
+    }
+
+    // volume multiplica el volumen del efecto. false si la cola está llena.
+    bool play(SoundId sound, float volume = 1.0f) {
+        return requests.push({ sound, volume });
+    }
+
+    void update() {
+        std::fill(startsThisFrame.begin(), startsThisFrame.end(), 0u);
+        unsigned started = 0;
+        Request request;
+        while (requests.pop(request)) {
+            const Sound& sound = sounds[request.sound];
+            if (started >= maxStartsPerFrame || startsThisFrame[request.sound] >= sound.settings.maxPerFrame) {
+                stats.dropped++;
+                continue;
+            }
+            Voice* voice = pickVoice(request.sound, sound.settings.priority);
+            if (!voice) {
+                stats.dropped++;
+                continue;
+            }
+            start(*voice, request, sound);
+            startsThisFrame[request.sound]++;
+            started++;
+        }
+    }
+
+    const MixerStats& getStats() const { return stats; }
+
+private:
+    static constexpr SoundId NO_SOUND = 0xFFFF;
+    static constexpr std::size_t QUEUE_SIZE = 256;
+
+    struct Sound {
+        AssetHandle<sf::SoundBuffer> buffer;
+        SoundSettings settings;
+    };
+
+    struct Request {
+        SoundId sound;
+        float volume;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        SoundId current = NO_SOUND;
+        std::uint8_t priority = 0;
+        std::uint64_t startOrder = 0;
+    };
+
+    // Preferencia: voz libre que ya tenga este buffer, cualquier voz libre,
+    // y por último la que suena con menor prioridad (la más antigua si empatan)
+    Voice* pickVoice(SoundId sound, std::uint8_t priority) {
+        Voice* freeVoice = nullptr;
+        Voice* victim = nullptr;
+        for (auto& voice : voices) {
+            if (voice.sound.getStatus() != sf::Sound::Playing) {
+                if (voice.current == sound) {
+                    return &voice;
+                }
+                if (!freeVoice) {
+                    freeVoice = &voice;
+                }
+            } else if (voice.priority <= priority
+                       && (!victim || voice.priority < victim->priority
+                           || (voice.priority == victim->priority && voice.startOrder < victim->startOrder))) {
+                victim = &voice;
+            }
+        }
+        if (freeVoice) {
+            return freeVoice;
+        }
+        if (victim) {
+            stats.stolen++;
+        }
+        return victim;
+    }
+
+    void start(Voice& voice, const Request& request, const Sound& sound) {
+        // Cambiar de buffer registra la voz en él; se evita si ya lo tenía
+        if (voice.current != request.sound) {
+            voice.sound.stop();
+            voice.sound.setBuffer(*sound.buffer);
+            voice.current = request.sound;
+        }
+        voice.sound.setVolume(sound.settings.volume * request.volume);
+        voice.priority = sound.settings.priority;
+        voice.startOrder = ++startCounter;
+        voice.sound.play();
+        stats.started++;
+    }
+
+    // Los buffers se declaran antes que las voces: se destruyen después
+    std::vector<Sound> sounds;
+    std::vector<unsigned> startsThisFrame;
+    std::vector<Voice> voices;
+    unsigned maxStartsPerFrame;
+    SpscQueue<Request, QUEUE_SIZE> requests;
+    std::uint64_t startCounter = 0;
+    MixerStats stats;
+};
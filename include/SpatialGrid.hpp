@@ -0,0 +1,116 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Contadores del broadphase para comprobar que el coste escala casi lineal
+struct CollisionStats {
+    std::uint64_t pairsTested = 0;
+    std::uint64_t pairsHit = 0;
+
+    void reset() {
+        pairsTested = 0;
+        pairsHit = 0;
+    }
+};
+
+// Rejilla uniforme para el broadphase de colisiones.
+// Se reconstruye cada tick con un counting sort: los ids de cada celda quedan
+// contiguos en 'cellItems' y, tras el primer tick, no se reserva memoria.
+// Las posiciones fuera del área se sujetan a las celdas del borde, así que
+// una consulta nunca pierde un par vecino (solo prueba alguno de más).
+class SpatialGrid {
+public:
+    SpatialGrid(float cellSize, float width, float height)
+        : cellSize(cellSize),
+          invCellSize(1.0f / cellSize),
+          cols(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+          rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+          cellStart(static_cast<size_t>(cols * rows) + 1, 0) {}
+
+    // Reserva para 'n' ids, así build() no vuelve a pedir memoria
+    void reserve(size_t n) {
+        pending.reserve(n);
+        cellItems.reserve(n);
+    }
+
+    void clear() {
+        pending.clear();
+    }
+
+    void insert(std::uint32_t id, const sf::Vector2f& position) {
+        pending.push_back({ cellIndex(cellX(position.x), cellY(position.y)), id });
+    }
+
+    // Ordena los ids insertados por celda (counting sort en dos pasadas)
+    void build() {
+        std::fill(cellStart.begin(), cellStart.end(), 0u);
+        for (const auto& item : pending) {
+            ++cellStart[item.cell + 1];
+        }
+        for (size_t i = 1; i < cellStart.size(); ++i) {
+            cellStart[i] += cellStart[i - 1];
+        }
+        cellItems.resize(pending.size());
+        cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        for (const auto& item : pending) {
+            cellItems[cursor[item.cell]++] = item.id;
+        }
+    }
+
+    // Llama a fn(id) por cada id guardado en las celdas que toca el cuadrado
+    // de lado 2*reach centrado en 'position'
+    template <typename Fn>
+    void query(const sf::Vector2f& position, float reach, Fn&& fn) const {
+        queryRect(position.x - reach, position.y - reach, position.x + reach, position.y + reach, fn);
+    }
+
+    // Igual, con las celdas que toca el rectángulo [minX, maxX] x [minY, maxY]
+    template <typename Fn>
+    void queryRect(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+        int x0 = cellX(minX);
+        int x1 = cellX(maxX);
+        int y0 = cellY(minY);
+        int y1 = cellY(maxY);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                int cell = cellIndex(x, y);
+                for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                    fn(cellItems[i]);
+                }
+            }
+        }
+    }
+
+    float getCellSize() const { return cellSize; }
+
+private:
+    struct Item {
+        int cell;
+        std::uint32_t id;
+    };
+
+    int cellX(float x) const {
+        return std::min(std::max(static_cast<int>(std::floor(x * invCellSize)), 0), cols - 1);
+    }
+
+    int cellY(float y) const {
+        return std::min(std::max(static_cast<int>(std::floor(y * invCellSize)), 0), rows - 1);
+    }
+
+    int cellIndex(int x, int y) const {
+        return y * cols + x;
+    }
+
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint32_t> cursor;
+    std::vector<std::uint32_t> cellItems;
+    std::vector<Item> pending;
+};
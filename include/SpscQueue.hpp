@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Cola sin bloqueos de un productor y un consumidor, de capacidad fija.
+// No reserva memoria: los elementos viven en un array circular. 'push' solo
+// lo llama el productor y 'pop' solo el consumidor (pueden ser hilos
+// distintos). Capacity debe ser potencia de dos.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de dos");
+
+public:
+    // false si la cola está llena (el elemento se descarta)
+    bool push(const T& item) {
+        std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[tail & (Capacity - 1)] = item;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[head & (Capacity - 1)];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> items;
+    // En líneas de caché distintas para que productor y consumidor no se pisen
+    alignas(64) std::atomic<std::size_t> headIndex{ 0 };
+    alignas(64) std::atomic<std::size_t> tailIndex{ 0 };
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Triple buffer sin bloqueos entre un escritor y un lector. El escritor
+// rellena su buffer y lo publica; el lector se queda siempre con el último
+// publicado. Ninguno espera al otro: si el escritor publica más rápido de lo
+// que el lector consume, los intermedios se descartan.
+//
+// Los tres T se crean al principio y se reutilizan, así que si T tiene
+// vectores, tras unos ciclos dejan de reservar memoria.
+template <typename T>
+class TripleBuffer {
+public:
+    // Buffer del escritor (solo lo toca el hilo escritor)
+    T& writeBuffer() { return buffers[writeIndex]; }
+
+    // Entrega el buffer del escritor y le da otro libre
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Pasa al último buffer publicado. true si había uno nuevo.
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        std::uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Buffer del lector (solo lo toca el hilo lector)
+    const T& readBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    T buffers[3];
+    std::uint8_t writeIndex = 0;
+    std::uint8_t readIndex = 1;
+    alignas(64) std::atomic<std::uint8_t> middle{ 2 };
+};
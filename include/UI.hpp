@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <deque>
+#include <string>
+
+// Colocación de un widget respecto a la ventana:
+// posición = anchor * tamaño_ventana + offset - pivot * tamaño_del_widget
+struct UILayout {
+    sf::Vector2f anchor;
+    sf::Vector2f offset;
+    sf::Vector2f pivot;
+};
+
+// Texto retenido: se construye una vez y solo se recoloca cuando cambia su
+// contenido o el tamaño de la ventana.
+class Label {
+public:
+    Label(const sf::Font& font, unsigned characterSize, const UILayout& layout, sf::Color color = sf::Color::White)
+        : layout(layout), dirty(true) {
+        text.setFont(font);
+        text.setCharacterSize(characterSize);
+        text.setFillColor(color);
+    }
+
+    // Solo marca el widget como sucio si el texto cambia de verdad
+    void setString(const std::string& value) {
+        if (value == current) {
+            return;
+        }
+        current = value;
+        text.setString(current);
+        dirty = true;
+    }
+
+    void relayout(const sf::Vector2u& windowSize) {
+        sf::FloatRect bounds = text.getLocalBounds();
+        text.setPosition(layout.anchor.x * windowSize.x + layout.offset.x - layout.pivot.x * bounds.width,
+                         layout.anchor.y * windowSize.y + layout.offset.y - layout.pivot.y * bounds.height);
+        dirty = false;
+    }
+
+    bool isDirty() const { return dirty; }
+    const sf::Text& getText() const { return text; }
+
+private:
+    sf::Text text;
+    std::string current;
+    UILayout layout;
+    bool dirty;
+};
+
+// Capa de interfaz (una pantalla o el HUD). Los textos se guardan entre
+// frames y solo se recolocan los que han cambiado (o todos si cambia el
+// tamaño de la ventana); dibujar la capa es dibujar esos textos tal cual.
+class UILayer {
+public:
+    Label& addLabel(const sf::Font& font, unsigned characterSize, const UILayout& layout,
+                    const std::string& value = "") {
+        labels.emplace_back(font, characterSize, layout);
+        labels.back().setString(value);
+        return labels.back();
+    }
+
+    void draw(sf::RenderTarget& target) {
+        sf::Vector2u size = target.getSize();
+        bool resized = size != layoutSize;
+        layoutSize = size;
+        for (auto& label : labels) {
+            if (resized || label.isDirty()) {
+                label.relayout(size);
+            }
+            target.draw(label.getText());
+        }
+    }
+
+private:
+    std::deque<Label> labels;  // deque: las referencias devueltas no se invalidan
+    sf::Vector2u layoutSize;
+};
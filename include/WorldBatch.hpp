@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.hpp"
+#include "JobSystem.hpp"
+#include "Simulation.hpp"
+
+// Muchas partidas independientes a la vez, para bots, entrenamiento y
+// pruebas automáticas. Cada mundo es una Simulation con su propia semilla y
+// sin estado compartido, así que se reparten entre los núcleos por trozos
+// de mundos (cada uno se simula en un solo hilo). Con la misma semilla y las
+// mismas acciones el resultado es el mismo con cualquier número de hilos.
+
+// Asteroides más cercanos a la nave que entran en la observación
+constexpr int OBS_NEAREST_ASTEROIDS = 8;
+// Valores por asteroide: posición relativa a la nave (x, y) y dirección (dx, dy)
+constexpr int OBS_ASTEROID_VALUES = 4;
+
+// Mundos por trozo de trabajo
+constexpr size_t BATCH_CHUNK_SIZE = 16;
+
+// Capacidades pequeñas para que miles de mundos quepan en memoria: con
+// SHOOT_DELAY y BULLET_LIFE nunca hay más de 16 balas vivas
+inline SimConfig batchWorldConfig() {
+    SimConfig config;
+    config.maxBullets = 64;
+    config.maxAsteroids = 256;
+    return config;
+}
+
+// Observaciones de todos los mundos en arrays planos: el mundo i ocupa la
+// posición i, o el tramo [i * K * 4, (i + 1) * K * 4) en 'asteroids'.
+// Las posiciones van en píxeles.
+struct BatchObservations {
+    std::vector<float> playerX, playerY;
+    std::vector<float> playerCos, playerSin;  // Hacia dónde apunta la nave
+    std::vector<float> asteroids;             // Del más cercano al más lejano; huecos a 0
+    std::vector<std::uint8_t> asteroidMask;   // 1 si el hueco tiene asteroide
+    std::vector<std::int32_t> score;          // Puntaje al final del paso (antes del reinicio)
+    std::vector<float> reward;                // Puntos ganados en este paso
+    std::vector<std::uint8_t> done;           // La partida terminó en este paso y ya se reinició
+
+    void resize(size_t worlds) {
+        playerX.assign(worlds, 0.0f);
+        playerY.assign(worlds, 0.0f);
+        playerCos.assign(worlds, 0.0f);
+        playerSin.assign(worlds, 0.0f);
+        asteroids.assign(worlds * OBS_NEAREST_ASTEROIDS * OBS_ASTEROID_VALUES, 0.0f);
+        asteroidMask.assign(worlds * OBS_NEAREST_ASTEROIDS, 0);
+        score.assign(worlds, 0);
+        reward.assign(worlds, 0.0f);
+        done.assign(worlds, 0);
+    }
+};
+
+class WorldBatch {
+public:
+    // El mundo i usa la semilla seed + i
+    WorldBatch(size_t worldCount, std::uint32_t seed, const SimConfig& config = batchWorldConfig(),
+               JobSystem* jobs = nullptr, float dt = SIM_DT)
+        : jobs(jobs), dt(dt) {
+        worlds.reserve(worldCount);
+        for (size_t i = 0; i < worldCount; i++) {
+            worlds.emplace_back(seed + static_cast<std::uint32_t>(i), config);
+        }
+        obs.resize(worldCount);
+        forEachWorld([this](size_t i) { observe(i); });
+    }
+
+    size_t size() const { return worlds.size(); }
+
+    // Avanza cada mundo un tick con actions[i] (InputBits) y devuelve las
+    // observaciones. Los mundos que pierden se reinician solos: done[i] = 1,
+    // score[i] es el puntaje final y el resto ya es de la partida nueva.
+    const BatchObservations& step(const std::uint8_t* actions) {
+        forEachWorld([this, actions](size_t i) {
+            Simulation& world = worlds[i];
+            int scoreBefore = world.score;
+            world.step(actions[i], dt);
+            obs.score[i] = world.score;
+            obs.reward[i] = static_cast<float>(world.score - scoreBefore);
+            obs.done[i] = world.gameOver ? 1 : 0;
+            if (world.gameOver) {
+                world.restart();
+            }
+            observe(i);
+        });
+        steps += worlds.size();
+        return obs;
+    }
+
+    // Todas las partidas de nuevo (continuando la secuencia aleatoria)
+    const BatchObservations& reset() {
+        forEachWorld([this](size_t i) {
+            worlds[i].restart();
+            obs.score[i] = 0;
+            obs.reward[i] = 0.0f;
+            obs.done[i] = 0;
+            observe(i);
+        });
+        return obs;
+    }
+
+    // Todos los mundos desde la misma foto (Simulation::save de un mundo con
+    // la misma configuración), por ejemplo para probar acciones distintas a
+    // partir de un mismo estado. False si la foto no encaja con los mundos.
+    bool fork(const SimCheckpoint& checkpoint) {
+        bool ok = true;
+        for (Simulation& world : worlds) {
+            ok = world.restore(checkpoint) && ok;
+        }
+        forEachWorld([this](size_t i) {
+            obs.score[i] = worlds[i].score;
+            obs.reward[i] = 0.0f;
+            obs.done[i] = 0;
+            observe(i);
+        });
+        return ok;
+    }
+
+    const BatchObservations& observations() const { return obs; }
+    const Simulation& world(size_t i) const { return worlds[i]; }
+
+    // Pasos de entorno (mundos x ticks) desde la creación
+    std::uint64_t stepsRun() const { return steps; }
+
+private:
+    template <typename Fn>
+    void forEachWorld(Fn&& fn) {
+        const size_t chunks = (worlds.size() + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+        auto runChunk = [&](size_t chunk, unsigned) {
+            size_t end = std::min((chunk + 1) * BATCH_CHUNK_SIZE, worlds.size());
+            for (size_t i = chunk * BATCH_CHUNK_SIZE; i < end; i++) {
+                fn(i);
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(chunks, runChunk);
+        } else {
+            for (size_t c = 0; c < chunks; ++c) {
+                runChunk(c, 0u);
+            }
+        }
+    }
+
+    // Nave y los K asteroides más cercanos (inserción ordenada en un array
+    // fijo: no reserva memoria)
+    void observe(size_t i) {
+        const Simulation& world = worlds[i];
+        const PlayerState& player = world.player;
+        obs.playerX[i] = player.position.x;
+        obs.playerY[i] = player.position.y;
+        obs.playerCos[i] = cosine(player.angle);
+        obs.playerSin[i] = sine(player.angle);
+
+        const AsteroidArrays& a = world.asteroids.arrays;
+        float nearestDist[OBS_NEAREST_ASTEROIDS];
+        std::uint32_t nearest[OBS_NEAREST_ASTEROIDS];
+        int found = 0;
+        for (size_t k = 0; k < a.size(); k++) {
+            float dx = a.x[k] - player.position.x;
+            float dy = a.y[k] - player.position.y;
+            float dist = dx * dx + dy * dy;
+            if (found == OBS_NEAREST_ASTEROIDS && dist >= nearestDist[found - 1]) {
+                continue;
+            }
+            int slot = found < OBS_NEAREST_ASTEROIDS ? found++ : found - 1;
+            while (slot > 0 && nearestDist[slot - 1] > dist) {
+                nearestDist[slot] = nearestDist[slot - 1];
+                nearest[slot] = nearest[slot - 1];
+                --slot;
+            }
+            nearestDist[slot] = dist;
+            nearest[slot] = static_cast<std::uint32_t>(k);
+        }
+
+        float* out = &obs.asteroids[i * OBS_NEAREST_ASTEROIDS * OBS_ASTEROID_VALUES];
+        std::uint8_t* mask = &obs.asteroidMask[i * OBS_NEAREST_ASTEROIDS];
+        for (int n = 0; n < OBS_NEAREST_ASTEROIDS; n++, out += OBS_ASTEROID_VALUES) {
+            if (n < found) {
+                std::uint32_t k = nearest[n];
+                out[0] = a.x[k] - player.position.x;
+                out[1] = a.y[k] - player.position.y;
+                out[2] = a.dx[k];
+                out[3] = a.dy[k];
+                mask[n] = 1;
+            } else {
+                out[0] = out[1] = out[2] = out[3] = 0.0f;
+                mask[n] = 0;
+            }
+        }
+    }
+
+    std::vector<Simulation> worlds;
+    JobSystem* jobs;
+    float dt;
+    BatchObservations obs;
+    std::uint64_t steps = 0;
+};
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "WorldBatch.hpp"
+
+// Muchos mundos a la vez con acciones pseudoaleatorias: mide los pasos de
+// entorno por segundo del API por lotes y cuenta las partidas terminadas.
+// El hash final de las observaciones debe salir igual con cualquier número
+// de hilos.
+//
+// Uso: batch_sim [--worlds N] [--steps T] [--threads H] [--seed S] [--asteroids K]
+
+int main(int argc, char* argv[]) {
+    size_t worldCount = 4096;
+    std::uint64_t steps = 1000;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::uint32_t seed = 1;
+    SimConfig config = batchWorldConfig();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--worlds" && hasValue) {
+            worldCount = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--steps" && hasValue) {
+            steps = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--asteroids" && hasValue) {
+            config.initialAsteroids = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--worlds N] [--steps T] [--threads H] [--seed S] [--asteroids K]" << std::endl;
+            return -1;
+        }
+    }
+
+    JobSystem jobs(threads);
+    WorldBatch batch(worldCount, seed, config, &jobs);
+    std::vector<std::uint8_t> actions(worldCount, 0);
+
+    // Política de prueba: cada mundo cambia de acción cada 8 ticks (xorshift)
+    std::uint32_t state = seed * 2654435761u + 1;
+    auto nextRandom = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    std::uint64_t episodes = 0;
+    std::uint64_t episodeScore = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t t = 0; t < steps; t++) {
+        if (t % 8 == 0) {
+            for (auto& action : actions) {
+                action = static_cast<std::uint8_t>(nextRandom() & (INPUT_LEFT | INPUT_RIGHT | INPUT_THRUST | INPUT_FIRE));
+            }
+        }
+        const BatchObservations& obs = batch.step(actions.data());
+        for (size_t i = 0; i < worldCount; i++) {
+            if (obs.done[i]) {
+                episodes++;
+                episodeScore += static_cast<std::uint64_t>(obs.score[i]);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Hash FNV-1a de la última observación
+    const BatchObservations& obs = batch.observations();
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(obs.playerX.data(), obs.playerX.size() * sizeof(float));
+    mix(obs.playerY.data(), obs.playerY.size() * sizeof(float));
+    mix(obs.asteroids.data(), obs.asteroids.size() * sizeof(float));
+    mix(obs.score.data(), obs.score.size() * sizeof(std::int32_t));
+
+    std::cout << "Mundos: " << worldCount << ", ticks: " << steps << " (semilla " << seed << ", " << jobs.size() << " hilos)" << std::endl;
+    std::cout << "Tiempo: " << seconds << " s, " << (seconds > 0.0 ? batch.stepsRun() / seconds : 0.0) << " pasos/s" << std::endl;
+    std::cout << "Partidas terminadas: " << episodes << ", puntaje medio "
+              << (episodes > 0 ? episodeScore / episodes : 0) << std::endl;
+    std::cout << "Hash de las observaciones: " << std::hex << hash << std::dec << std::endl;
+    return 0;
+}
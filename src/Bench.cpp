@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CollisionDriver.hpp"
+#include "EntityArrays.hpp"
+#include "EntityPool.hpp"
+#include "GameConfig.hpp"
+#include "ParticleSystem.hpp"
+#include "Simulation.hpp"
+
+// Microbenchmarks de los kernels del camino caliente: colisión círculo a
+// círculo, SAT por nombre y por handle, altas/bajas en el pool de entidades,
+// integración de balas, asteroides y partículas, la restauración de una
+// foto del mundo y el tick completo de la simulación (en la ventana y en un
+// mundo grande, con y sin ritmo reducido lejos de la nave).
+// Cada uno se mide con varios números de entidades y una semilla fija, y el
+// resultado (ns por operación) se guarda en JSON. Con --baseline se compara
+// con un JSON anterior y se marcan las regresiones.
+//
+// Uso: bench [--counts 10,100,...] [--seed S] [--samples K] [--filter texto]
+//            [--out resultados.json] [--baseline base.json] [--threshold PCT] [--list]
+
+// Evita que el compilador descarte los resultados de los kernels
+volatile std::uint64_t benchSink = 0;
+
+// Una pasada hace 'count' operaciones sobre datos ya preparados
+using BenchPass = std::function<void()>;
+
+struct BenchCase {
+    const char* name;
+    const char* description;
+    std::function<BenchPass(std::uint64_t count, std::uint32_t seed)> setup;
+};
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t count = 0;
+    double nsPerOp = 0.0;     // Mediana de las muestras
+    double minNsPerOp = 0.0;
+    int samples = 0;
+};
+
+// Polígonos convexos regulares de 3 a 8 lados, repartidos para que haya
+// tanto pares que chocan como pares separados
+std::vector<std::vector<sf::Vector2f>> randomPolygons(size_t count, std::mt19937& gen) {
+    std::uniform_int_distribution<int> sides(3, 8);
+    std::uniform_real_distribution<float> radius(10.0f, 40.0f);
+    std::uniform_real_distribution<float> coord(0.0f, 300.0f);
+    std::uniform_real_distribution<float> turn(0.0f, 2.0f * M_P);
+    std::vector<std::vector<sf::Vector2f>> polygons(count);
+    for (auto& polygon : polygons) {
+        int n = sides(gen);
+        float r = radius(gen);
+        sf::Vector2f center(coord(gen), coord(gen));
+        float start = turn(gen);
+        for (int k = 0; k < n; k++) {
+            float angle = start + 2.0f * M_P * k / n;
+            polygon.push_back({ center.x + r * std::cos(angle), center.y + r * std::sin(angle) });
+        }
+    }
+    return polygons;
+}
+
+// Tick completo en un mundo que crece con N (unos 50 asteroides por pantalla
+// de superficie); 'farTickInterval' 1 mueve y comprueba todo en cada tick
+BenchPass worldStepPass(std::uint64_t count, std::uint32_t seed, std::uint32_t farTickInterval) {
+    const float screens = std::max(1.0f, std::sqrt(static_cast<float>(count) / 50.0f));
+    SimConfig config;
+    config.initialAsteroids = static_cast<std::uint32_t>(count);
+    config.maxAsteroids = std::max(config.maxAsteroids, static_cast<std::uint32_t>(count));
+    config.invulnerable = true;
+    config.worldWidth = SCREEN_WIDTH * screens;
+    config.worldHeight = SCREEN_HEIGHT * screens;
+    config.farTickInterval = farTickInterval;
+    auto sim = std::make_shared<Simulation>(seed, config);
+    auto input = std::make_shared<ScriptedInput>(seed);
+    return [sim, input]() {
+        sim->step(input->next(sim->tick), SIM_DT);
+        benchSink = benchSink + static_cast<std::uint64_t>(sim->events.kills);
+    };
+}
+
+const std::vector<BenchCase>& benchCases() {
+    static const std::vector<BenchCase> cases = {
+        { "circle_check", "checkCollision entre pares de círculos",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              std::uniform_real_distribution<float> coord(0.0f, SCREEN_WIDTH);
+              std::uniform_real_distribution<float> radius(BULLET_RADIUS, ASTEROID_W / 2.0f);
+              auto positions = std::make_shared<std::vector<sf::Vector2f>>(count);
+              auto radii = std::make_shared<std::vector<float>>(count);
+              for (size_t i = 0; i < count; i++) {
+                  (*positions)[i] = { coord(gen), coord(gen) * (SCREEN_HEIGHT / SCREEN_WIDTH) };
+                  (*radii)[i] = radius(gen);
+              }
+              return [positions, radii, count]() {
+                  const auto& p = *positions;
+                  const auto& r = *radii;
+                  std::uint64_t hits = 0;
+                  for (size_t i = 0; i < count; i++) {
+                      size_t j = i + 1 < count ? i + 1 : 0;
+                      hits += checkCollision(p[i], r[i], p[j], r[j]) ? 1 : 0;
+                  }
+                  benchSink = benchSink + hits;
+              };
+          } },
+        { "sat_by_name", "CollisionDriver::checkCollision(\"sat\", ...) buscando el método por nombre",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto polygons = std::make_shared<std::vector<std::vector<sf::Vector2f>>>(
+                  randomPolygons(std::min<std::uint64_t>(count, 1024), gen));
+              auto driver = std::make_shared<CollisionDriver>();
+              return [polygons, driver, count]() {
+                  const auto& p = *polygons;
+                  const size_t n = p.size();
+                  std::uint64_t hits = 0;
+                  for (size_t i = 0; i < count; i++) {
+                      hits += driver->checkCollision("sat", p[i % n], p[(i * 7 + 3) % n]) ? 1 : 0;
+                  }
+                  benchSink = benchSink + hits;
+              };
+          } },
+        { "sat_by_handle", "CollisionDriver::checkCollision con el método ya resuelto",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto polygons = std::make_shared<std::vector<std::vector<sf::Vector2f>>>(
+                  randomPolygons(std::min<std::uint64_t>(count, 1024), gen));
+              auto driver = std::make_shared<CollisionDriver>();
+              CollisionDriver::MethodHandle sat = driver->resolve("sat");
+              return [polygons, driver, sat, count]() {
+                  const auto& p = *polygons;
+                  const size_t n = p.size();
+                  std::uint64_t hits = 0;
+                  for (size_t i = 0; i < count; i++) {
+                      hits += driver->checkCollision(sat, p[i % n], p[(i * 7 + 3) % n]) ? 1 : 0;
+                  }
+                  benchSink = benchSink + hits;
+              };
+          } },
+        { "pool_spawn_kill", "EntityPool: alta de todas las entidades y baja en orden aleatorio (1 op = alta + baja)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto pool = std::make_shared<EntityPool<AsteroidArrays>>(static_cast<std::uint32_t>(count));
+              auto handles = std::make_shared<std::vector<EntityHandle>>(count);
+              auto order = std::make_shared<std::vector<std::uint32_t>>(count);
+              std::iota(order->begin(), order->end(), 0u);
+              std::shuffle(order->begin(), order->end(), gen);
+              return [pool, handles, order, count]() {
+                  auto& h = *handles;
+                  for (size_t i = 0; i < count; i++) {
+                      h[i] = pool->spawn(sf::Vector2f(static_cast<float>(i & 1023), 0.0f), sf::Vector2f(1.0f, 0.0f));
+                  }
+                  std::uint64_t killed = 0;
+                  for (std::uint32_t i : *order) {
+                      killed += pool->kill(h[i]) ? 1 : 0;
+                  }
+                  benchSink = benchSink + killed;
+              };
+          } },
+        { "integrate_bullets", "integrateBullets (movimiento y vida de las balas)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto bullets = std::make_shared<BulletArrays>();
+              bullets->reserve(count);
+              for (size_t i = 0; i < count; i++) {
+                  bullets->push(randomAsteroidPosition(gen), randomAsteroidDirection(gen), BULLET_LIFE);
+              }
+              return [bullets]() {
+                  integrateBullets(*bullets, BULLET_SPEED, SIM_DT);
+                  benchSink = benchSink + static_cast<std::uint64_t>(bullets->x[0] != 0.0f);
+              };
+          } },
+        { "integrate_asteroids", "integrateAsteroids (movimiento, giro y rebote)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto asteroids = std::make_shared<AsteroidArrays>();
+              asteroids->reserve(count);
+              for (size_t i = 0; i < count; i++) {
+                  asteroids->push(randomAsteroidPosition(gen), randomAsteroidDirection(gen));
+              }
+              return [asteroids]() {
+                  integrateAsteroids(*asteroids, ASTEROID_SPEED, ASTEROID_SPIN, ASTEROID_BOUNDS, SIM_DT);
+                  benchSink = benchSink + static_cast<std::uint64_t>(asteroids->x[0] != 0.0f);
+              };
+          } },
+        { "sincos_table", "sinCos de ángulos binarios (tabla e interpolación entera)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto angles = std::make_shared<std::vector<BinaryAngle>>(count);
+              auto out = std::make_shared<std::vector<float>>(2 * count);
+              for (BinaryAngle& angle : *angles) {
+                  angle = static_cast<BinaryAngle>(gen());
+              }
+              return [angles, out, count]() {
+                  sinCos(angles->data(), out->data(), out->data() + count, count);
+                  benchSink = benchSink + static_cast<std::uint64_t>((*out)[0] != 0.0f);
+              };
+          } },
+        { "sincos_std", "std::cos y std::sin de los mismos ángulos en radianes (referencia)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              std::mt19937 gen(seed);
+              auto angles = std::make_shared<std::vector<float>>(count);
+              auto out = std::make_shared<std::vector<float>>(2 * count);
+              for (float& angle : *angles) {
+                  angle = static_cast<float>(angleToRadians(static_cast<BinaryAngle>(gen())));
+              }
+              return [angles, out, count]() {
+                  for (size_t i = 0; i < count; i++) {
+                      (*out)[i] = std::cos((*angles)[i]);
+                      (*out)[count + i] = std::sin((*angles)[i]);
+                  }
+                  benchSink = benchSink + static_cast<std::uint64_t>((*out)[0] != 0.0f);
+              };
+          } },
+        { "particles_update", "ParticleSystem::update (movimiento, frenado y bajas de las apagadas)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              // Vida larga: ninguna se apaga durante la medida y el pool no cambia
+              auto particles = std::make_shared<ParticleSystem>(static_cast<std::uint32_t>(count), seed);
+              particles->burst({ SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 }, static_cast<std::uint32_t>(count),
+                               200.0f, 1e9f, 0xFFFFFF00);
+              return [particles]() {
+                  particles->update(SIM_DT);
+                  benchSink = benchSink + static_cast<std::uint64_t>(particles->size());
+              };
+          } },
+        { "simulation_restore", "Simulation::restore de una foto con N asteroides (1 op = un asteroide)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              SimConfig config;
+              config.initialAsteroids = static_cast<std::uint32_t>(count);
+              config.maxAsteroids = static_cast<std::uint32_t>(count);
+              auto sim = std::make_shared<Simulation>(seed, config);
+              auto checkpoint = std::make_shared<SimCheckpoint>();
+              sim->save(*checkpoint);
+              return [sim, checkpoint]() {
+                  sim->restore(*checkpoint);
+                  benchSink = benchSink + static_cast<std::uint64_t>(sim->asteroids.size());
+              };
+          } },
+        { "simulation_step", "Simulation::step con N asteroides iniciales, en un hilo (1 op = un asteroide en un tick)",
+          [](std::uint64_t count, std::uint32_t seed) -> BenchPass {
+              SimConfig config;
+              config.initialAsteroids = static_cast<std::uint32_t>(count);
+              config.maxAsteroids = std::max(config.maxAsteroids, static_cast<std::uint32_t>(count));
+              config.invulnerable = true;
+              auto sim = std::make_shared<Simulation>(seed, config);
+              auto input = std::make_shared<ScriptedInput>(seed);
+              return [sim, input]() {
+                  sim->step(input->next(sim->tick), SIM_DT);
+                  benchSink = benchSink + static_cast<std::uint64_t>(sim->events.kills);
+              };
+          } },
+        { "world_step", "Simulation::step en un mundo grande proporcional a N, todo a cada tick (1 op = un asteroide en un tick)",
+          [](std::uint64_t count, std::uint32_t seed) { return worldStepPass(count, seed, 1); } },
+        { "world_step_far", "Como world_step, pero lejos de la nave se avanza uno de cada 4 ticks",
+          [](std::uint64_t count, std::uint32_t seed) { return worldStepPass(count, seed, 4); } },
+    };
+    return cases;
+}
+
+// Trabajo mínimo por muestra: las pasadas con pocas entidades se repiten
+constexpr std::uint64_t MIN_OPS_PER_SAMPLE = 1 << 18;
+
+BenchResult runCase(const BenchCase& bench, std::uint64_t count, std::uint32_t seed, int samples) {
+    BenchPass pass = bench.setup(count, seed);
+    pass();  // Calentamiento (cachés, páginas, predictor)
+
+    const std::uint64_t repeats = std::max<std::uint64_t>(1, MIN_OPS_PER_SAMPLE / count);
+    std::vector<double> nsPerOp;
+    for (int s = 0; s < samples; s++) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t r = 0; r < repeats; r++) {
+            pass();
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        nsPerOp.push_back(ns / static_cast<double>(repeats * count));
+    }
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    BenchResult result;
+    result.name = bench.name;
+    result.count = count;
+    result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+    result.minNsPerOp = nsPerOp.front();
+    result.samples = samples;
+    return result;
+}
+
+bool writeJson(const std::string& path, const std::vector<BenchResult>& results, std::uint32_t seed) {
+    std::ofstream out(path);
+    out << "{\n  \"seed\": " << seed << ",\n  \"simd_width\": " << SHOOT_SIMD_WIDTH << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"count\": %llu, \"ns_per_op\": %.4f, \"min_ns_per_op\": %.4f, \"samples\": %d}%s\n",
+                      r.name.c_str(), static_cast<unsigned long long>(r.count), r.nsPerOp, r.minNsPerOp, r.samples,
+                      i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Lee los resultados de un JSON escrito por writeJson (un objeto por
+// resultado; no es un lector de JSON general)
+bool readJson(const std::string& path, std::vector<BenchResult>& results) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto numberAfter = [&text](const char* key, size_t from, size_t to, double& value) {
+        size_t pos = text.find(key, from);
+        if (pos == std::string::npos || pos > to) {
+            return false;
+        }
+        pos = text.find(':', pos);
+        value = std::strtod(text.c_str() + pos + 1, nullptr);
+        return true;
+    };
+
+    size_t pos = 0;
+    while ((pos = text.find("\"name\"", pos)) != std::string::npos) {
+        size_t end = text.find('}', pos);
+        size_t open = text.find('"', text.find(':', pos));
+        size_t close = text.find('"', open + 1);
+        if (end == std::string::npos || open == std::string::npos || close == std::string::npos) {
+            return false;
+        }
+        BenchResult r;
+        r.name = text.substr(open + 1, close - open - 1);
+        double count = 0.0;
+        if (!numberAfter("\"count\"", pos, end, count) || !numberAfter("\"ns_per_op\"", pos, end, r.nsPerOp)) {
+            return false;
+        }
+        if (!numberAfter("\"min_ns_per_op\"", pos, end, r.minNsPerOp)) {
+            r.minNsPerOp = r.nsPerOp;
+        }
+        r.count = static_cast<std::uint64_t>(count);
+        results.push_back(r);
+        pos = end;
+    }
+    return true;
+}
+
+// Compara con la base; devuelve cuántas regresiones hay. Se compara el
+// mínimo de las muestras, que es lo que menos varía con el ruido de la máquina.
+int compareWithBaseline(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline, double threshold) {
+    int regressions = 0;
+    std::printf("\n%-22s %9s %12s %12s %9s\n", "benchmark", "N", "base min", "min", "cambio");
+    for (const BenchResult& r : results) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&r](const BenchResult& b) {
+            return b.name == r.name && b.count == r.count;
+        });
+        if (it == baseline.end() || it->minNsPerOp <= 0.0) {
+            std::printf("%-22s %9llu %12s %12.4f %9s\n", r.name.c_str(), static_cast<unsigned long long>(r.count), "-",
+                        r.minNsPerOp, "nuevo");
+            continue;
+        }
+        double change = (r.minNsPerOp - it->minNsPerOp) / it->minNsPerOp * 100.0;
+        const char* flag = "";
+        if (change > threshold) {
+            flag = "  REGRESIÓN";
+            regressions++;
+        } else if (change < -threshold) {
+            flag = "  mejora";
+        }
+        std::printf("%-22s %9llu %12.4f %12.4f %+8.1f%%%s\n", r.name.c_str(), static_cast<unsigned long long>(r.count),
+                    it->minNsPerOp, r.minNsPerOp, change, flag);
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::uint64_t> counts = { 10, 100, 1000, 10000, 100000, 1000000 };
+    std::uint32_t seed = 1;
+    int samples = 5;
+    std::string filter;
+    std::string outPath = "bench.json";
+    std::string baselinePath;
+    double threshold = 10.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--counts" && hasValue) {
+            counts.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                counts.push_back(std::max<std::uint64_t>(1, std::strtoull(item.c_str(), nullptr, 10)));
+            }
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--samples" && hasValue) {
+            samples = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--threshold" && hasValue) {
+            threshold = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--list") {
+            for (const BenchCase& bench : benchCases()) {
+                std::printf("%-22s %s\n", bench.name, bench.description);
+            }
+            return 0;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--counts 10,100,...] [--seed S] [--samples K] [--filter texto]"
+                      << " [--out resultados.json] [--baseline base.json] [--threshold PCT] [--list]" << std::endl;
+            return -1;
+        }
+    }
+
+    // Leer la base antes de medir para no perder el tiempo si no existe
+    std::vector<BenchResult> baseline;
+    if (!baselinePath.empty() && !readJson(baselinePath, baseline)) {
+        std::cerr << "Error al leer la base " << baselinePath << std::endl;
+        return -1;
+    }
+
+    std::vector<BenchResult> results;
+    std::printf("%-22s %9s %12s %12s %14s\n", "benchmark", "N", "ns/op", "min ns/op", "Mop/s");
+    for (const BenchCase& bench : benchCases()) {
+        if (!filter.empty() && std::string(bench.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        for (std::uint64_t count : counts) {
+            BenchResult r = runCase(bench, count, seed, samples);
+            std::printf("%-22s %9llu %12.4f %12.4f %14.2f\n", r.name.c_str(), static_cast<unsigned long long>(r.count),
+                        r.nsPerOp, r.minNsPerOp, r.nsPerOp > 0.0 ? 1000.0 / r.nsPerOp : 0.0);
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+    }
+
+    if (!writeJson(outPath, results, seed)) {
+        std::cerr << "Error al escribir " << outPath << std::endl;
+        return -1;
+    }
+    std::cout << "Resultados en " << outPath << std::endl;
+
+    if (!baselinePath.empty()) {
+        int regressions = compareWithBaseline(results, baseline, threshold);
+        std::cout << regressions << " regresiones de más del " << threshold << "% frente a " << baselinePath << std::endl;
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "AssetArchive.hpp"
+
+// Empaqueta un directorio de recursos en un único archivo (formato en
+// AssetArchive.hpp). Los sonidos cortos se decodifican aquí y se guardan
+// como PCM, así el juego no tiene que decodificar MP3/WAV al arrancar; la
+// música larga se deja tal cual porque se reproduce en streaming.
+//
+// Uso: pack_assets [directorio] [salida] [--max-pcm-seconds S]
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+    PakEntry entry;
+    std::vector<char> bytes;
+};
+
+static bool isAudio(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".wav" || ext == ".ogg" || ext == ".flac" || ext == ".mp3";
+}
+
+static std::vector<char> readFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static PackedFile packFile(const fs::path& path, float maxPcmSeconds) {
+    PackedFile packed;
+    std::memset(&packed.entry, 0, sizeof(PakEntry));
+    std::string name = path.generic_string();
+    std::strncpy(packed.entry.name, name.c_str(), PAK_NAME_SIZE - 1);
+    packed.entry.type = PakEntryType::Raw;
+    packed.bytes = readFile(path);
+
+    if (isAudio(path)) {
+        sf::SoundBuffer buffer;
+        if (buffer.loadFromMemory(packed.bytes.data(), packed.bytes.size())
+            && buffer.getDuration().asSeconds() <= maxPcmSeconds) {
+            const char* samples = reinterpret_cast<const char*>(buffer.getSamples());
+            packed.entry.type = PakEntryType::Pcm;
+            packed.entry.sampleRate = buffer.getSampleRate();
+            packed.entry.channelCount = buffer.getChannelCount();
+            packed.bytes.assign(samples, samples + buffer.getSampleCount() * sizeof(sf::Int16));
+        }
+    }
+    packed.entry.size = packed.bytes.size();
+    return packed;
+}
+
+int main(int argc, char* argv[]) {
+    std::string root = "assets";
+    std::string output = "assets.pak";
+    float maxPcmSeconds = 5.0f;
+
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--max-pcm-seconds" && i + 1 < argc) {
+            maxPcmSeconds = std::strtof(argv[++i], nullptr);
+        } else if (arg.rfind("--", 0) != 0 && positional.size() < 2) {
+            positional.push_back(arg);
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [directorio] [salida] [--max-pcm-seconds S]" << std::endl;
+            return -1;
+        }
+    }
+    if (positional.size() > 0) root = positional[0];
+    if (positional.size() > 1) output = positional[1];
+
+    std::error_code error;
+    std::vector<fs::path> paths;
+    for (const auto& item : fs::recursive_directory_iterator(root, error)) {
+        if (item.is_regular_file()) {
+            paths.push_back(item.path());
+        }
+    }
+    if (error) {
+        std::cerr << "Error al recorrer " << root << ": " << error.message() << std::endl;
+        return -1;
+    }
+    // Orden fijo: el mismo directorio siempre produce el mismo archivo
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<PackedFile> files;
+    for (const auto& path : paths) {
+        if (path.generic_string().size() >= PAK_NAME_SIZE) {
+            std::cerr << "Nombre demasiado largo, se omite: " << path.generic_string() << std::endl;
+            continue;
+        }
+        files.push_back(packFile(path, maxPcmSeconds));
+    }
+
+    auto align = [](std::uint64_t offset) {
+        return (offset + PAK_ALIGNMENT - 1) / PAK_ALIGNMENT * PAK_ALIGNMENT;
+    };
+    std::uint64_t offset = align(sizeof(PakHeader) + files.size() * sizeof(PakEntry));
+    for (auto& file : files) {
+        file.entry.offset = offset;
+        offset = align(offset + file.entry.size);
+    }
+
+    PakHeader header;
+    std::memcpy(header.magic, PAK_MAGIC, sizeof(PAK_MAGIC));
+    header.version = PAK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    header.reserved = 0;
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error al crear " << output << std::endl;
+        return -1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& file : files) {
+        out.write(reinterpret_cast<const char*>(&file.entry), sizeof(PakEntry));
+    }
+    const char padding[PAK_ALIGNMENT] = {};
+    for (const auto& file : files) {
+        out.write(padding, static_cast<std::streamsize>(file.entry.offset - static_cast<std::uint64_t>(out.tellp())));
+        out.write(file.bytes.data(), static_cast<std::streamsize>(file.bytes.size()));
+    }
+    if (!out) {
+        std::cerr << "Error al escribir " << output << std::endl;
+        return -1;
+    }
+
+    for (const auto& file : files) {
+        std::cout << (file.entry.type == PakEntryType::Pcm ? "pcm " : "raw ") << file.entry.name
+                  << " (" << file.entry.size << " bytes)" << std::endl;
+    }
+    std::cout << files.size() << " recursos en " << output << " (" << out.tellp() << " bytes)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "PhysicsSimulation.hpp"
+#include "Simulation.hpp"
+
+// Compara el camino propio (rejilla + círculo envolvente + casco exacto)
+// con Chipmunk (hash espacial + manejadores de colisión) con las mismas
+// entidades: misma semilla, mismos asteroides iniciales y misma entrada
+// guionizada. Las dos van en un solo hilo para que la comparación sea justa.
+//
+// Uso: physics_bench [--ticks N] [--seed S] [--asteroids A,B,C]
+
+struct BenchResult {
+    double seconds = 0.0;
+    std::uint64_t kills = 0;
+    std::uint64_t pairsHit = 0;
+    size_t bulletSum = 0;
+};
+
+template <typename World>
+BenchResult runWorld(std::uint32_t seed, const SimConfig& config, std::uint64_t ticks) {
+    World world(seed, config);
+    ScriptedInput input(seed);
+    BenchResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t t = 0; t < ticks; t++) {
+        world.step(input.next(world.tick), SIM_DT);
+        result.kills += static_cast<std::uint64_t>(world.events.kills);
+        result.bulletSum += world.bullets.size();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.pairsHit = world.stats.pairsHit;
+    return result;
+}
+
+void printResult(const char* name, const BenchResult& result, std::uint64_t ticks) {
+    std::cout << "  " << name << ": " << static_cast<std::uint64_t>(ticks / result.seconds) << " ticks/s, "
+              << result.seconds * 1000.0 / ticks << " ms/tick, " << result.kills << " bajas, "
+              << result.bulletSum / ticks << " balas de media" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::uint64_t ticks = 2000;
+    std::uint32_t seed = 1;
+    std::vector<std::uint32_t> counts = { 250, 1000, 4000 };
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--ticks" && hasValue) {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--asteroids" && hasValue) {
+            counts.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                counts.push_back(static_cast<std::uint32_t>(std::strtoul(item.c_str(), nullptr, 10)));
+            }
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--ticks N] [--seed S] [--asteroids A,B,C]" << std::endl;
+            return -1;
+        }
+    }
+    if (ticks == 0) {
+        return 0;
+    }
+
+    for (std::uint32_t count : counts) {
+        SimConfig config;
+        config.initialAsteroids = count;
+        config.invulnerable = true;
+
+        std::cout << count << " asteroides, " << ticks << " ticks:" << std::endl;
+        printResult("propio  ", runWorld<Simulation>(seed, config, ticks), ticks);
+        printResult("chipmunk", runWorld<PhysicsSimulation>(seed, config, ticks), ticks);
+    }
+    return 0;
+}
@@ -2,513 +2,612 @@
 #include <iostream>
 #include <cmath>
 #include <vector>
-#include <list>
 #include <random>
 #include <algorithm>
 #include <SFML/Audio.hpp>
-#include <functional>
-
-// Constantes
-constexpr float SCREEN_WIDTH = 1200.0f;
-constexpr float SCREEN_HEIGHT = 900.0f;
-constexpr float M_P = 3.14159265f;
-
-constexpr float PLAYER_W = 50.0f;
-constexpr float PLAYER_H = 40.0f;
-constexpr float TURN_SPEED = 200.0f;
-constexpr float PLAYER_SPEED = 200.0f;
-constexpr float SHOOT_DELAY = 0.2f;
-constexpr float BULLET_SPEED = 400.0f;
-constexpr float BULLET_LIFE = 3.0f;
-
-constexpr float ASTEROID_W = 90.0f;
-constexpr float ASTEROID_H = 80.0f;
-constexpr float ASTEROID_SPIN = 25.0f;
-constexpr float ASTEROID_SPEED = 280.0f;
-constexpr float ASTEROID_SPAWN_TIME = 3.0f;
-
-// Función auxiliar para verificar colisión circular
-bool checkCollision(const sf::Vector2f& pos1, float radius1, const sf::Vector2f& pos2, float radius2) {
-    float dx = pos1.x - pos2.x;
-    float dy = pos1.y - pos2.y;
-    float distanceSquared = dx * dx + dy * dy;
-    float radiusSum = radius1 + radius2;
-    return distanceSquared <= (radiusSum * radiusSum);
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <type_traits>
+#include "GameConfig.hpp"
+#include "SimulationThread.hpp"
+#include "PhysicsSimulation.hpp"
+#include "RenderBatcher.hpp"
+#include "UI.hpp"
+#include "AssetCache.hpp"
+#include "SoundMixer.hpp"
+#include "Profiler.hpp"
+#include "InputRecording.hpp"
+#include "FramePacer.hpp"
+#include "ParticleSystem.hpp"
+
+// Rutas de los recursos
+const std::string FONT_PATH = "assets/fonts/Minecraft.ttf";
+const std::string SHOOT_SOUND_PATH = "assets/music/shoot.wav";
+const std::string EXPLOSION_SOUND_PATH = "assets/music/pop.mp3";
+const std::string MUSIC_PATH = "assets/music/message-of-the-sun-72756.mp3";
+// Archivo empaquetado (make pack); si no existe se leen los archivos sueltos
+const std::string ARCHIVE_PATH = "assets.pak";
+
+// Exportación del profiler (tecla F4): render y simulación por separado
+const std::string PROFILE_CSV_PATH = "profile.csv";
+const std::string PROFILE_TRACE_PATH = "profile.json";
+const std::string SIM_PROFILE_CSV_PATH = "profile_sim.csv";
+const std::string SIM_PROFILE_TRACE_PATH = "profile_sim.json";
+
+// Frames entre actualizaciones del texto del overlay del profiler (F3)
+constexpr int PROFILE_OVERLAY_INTERVAL = 30;
+
+// Efectos de partículas: chispas por asteroide destruido y estela de la nave
+// (partículas por segundo mientras acelera), colores en 0xRRGGBB00
+constexpr std::uint32_t EXPLOSION_PARTICLES = 96;
+constexpr float EXPLOSION_SPEED = 220.0f;
+constexpr float EXPLOSION_LIFE = 0.9f;
+constexpr std::uint32_t EXPLOSION_COLOR = 0xFFD27800;
+constexpr float THRUST_PARTICLE_RATE = 900.0f;
+constexpr float THRUST_SPEED = 160.0f;
+constexpr BinaryAngle THRUST_SPREAD = angleFromDegrees(18.0f);
+constexpr float THRUST_LIFE = 0.45f;
+constexpr std::uint32_t THRUST_COLOR = 0x6FB4FF00;
+// Distancia del centro de la nave a la tobera (PLAYER_HULL)
+constexpr float THRUST_OFFSET = 15.0f;
+
+// En un mundo más grande que la ventana, los asteroides lejos de la nave
+// avanzan uno de cada tantos ticks (SimConfig::farTickInterval)
+constexpr std::uint32_t FAR_TICK_INTERVAL = 4;
+
+// Contar las reservas de memoria para el profiler
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
 }
 
-// Clase para manejar métodos de detección de colisión
-class CollisionDriver {
-public:
-    using CollisionMethod = std::function<bool(const std::vector<sf::Vector2f>&, const std::vector<sf::Vector2f>&)>;
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
 
-    CollisionDriver() {
-        // Registrar el método SAT por defecto
-        methods["sat"] = polygonIntersectionSAT;
-    }
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
 
-    void addMethod(const std::string& name, CollisionMethod method) {
-        methods[name] = method;
-    }
+// Mallas inmutables compartidas por todas las instancias
+const LineMesh ASTEROID_MESH(ASTEROID_HULL, 12);
+const LineMesh PLAYER_MESH(PLAYER_HULL, 5);
 
-    bool checkCollision(const std::string& method, const std::vector<sf::Vector2f>& poly1, const std::vector<sf::Vector2f>& poly2) {
-        if (methods.find(method) == methods.end()) {
-            throw std::runtime_error("Método no encontrado: " + method);
-        }
-        return methods[method](poly1, poly2);
+// Muestrear el teclado en la máscara de entrada de un tick
+std::uint8_t sampleKeyboard() {
+    std::uint8_t input = 0;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+        input |= INPUT_LEFT;
     }
-
-private:
-    std::map<std::string, CollisionMethod> methods;
-
-    // Implementación del algoritmo SAT
-    static bool polygonIntersectionSAT(const std::vector<sf::Vector2f>& poly1, const std::vector<sf::Vector2f>& poly2) {
-        auto getAxes = [](const std::vector<sf::Vector2f>& poly) {
-            std::vector<sf::Vector2f> axes;
-            for (size_t i = 0; i < poly.size(); ++i) {
-                sf::Vector2f p1 = poly[i];
-                sf::Vector2f p2 = poly[(i + 1) % poly.size()];
-                sf::Vector2f edge = { p2.x - p1.x, p2.y - p1.y };
-                sf::Vector2f normal = { -edge.y, edge.x };
-                float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
-                axes.push_back({ normal.x / length, normal.y / length });
-            }
-            return axes;
-        };
-
-        auto projectPolygon = [](const std::vector<sf::Vector2f>& poly, const sf::Vector2f& axis) {
-            float min = poly[0].x * axis.x + poly[0].y * axis.y;
-            float max = min;
-            for (const auto& vertex : poly) {
-                float projection = vertex.x * axis.x + vertex.y * axis.y;
-                if (projection < min) min = projection;
-                if (projection > max) max = projection;
-            }
-            return std::make_pair(min, max);
-        };
-
-        auto overlap = [](const std::pair<float, float>& proj1, const std::pair<float, float>& proj2) {
-            return proj1.second >= proj2.first && proj2.second >= proj1.first;
-        };
-
-        auto axes1 = getAxes(poly1);
-        auto axes2 = getAxes(poly2);
-
-        for (const auto& axis : axes1) {
-            if (!overlap(projectPolygon(poly1, axis), projectPolygon(poly2, axis))) {
-                return false;  // Separación encontrada
-            }
-        }
-
-        for (const auto& axis : axes2) {
-            if (!overlap(projectPolygon(poly1, axis), projectPolygon(poly2, axis))) {
-                return false;  // Separación encontrada
-            }
-        }
-
-        return true;  // No se encontró separación, hay intersección
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+        input |= INPUT_RIGHT;
     }
-};
-
-// Clase base para entidades
-class Entity {
-public:
-    Entity(sf::Vector2f position, float angle) : position(position), angle(angle) {}
-    virtual void update(float deltaTime) = 0;
-    virtual void render(sf::RenderWindow& window) = 0;
-    virtual ~Entity() = default;
-    sf::Vector2f position;
-    float angle;
-};
-
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+        input |= INPUT_THRUST;
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+        input |= INPUT_FIRE;
+    }
+    return input;
+}
 
-// Vectores globales para manejar entidades
-std::vector<Entity*> entities{};
-std::list<Entity*> toRemoveList{};
-std::list<Entity*> toAddList{};
+sf::Vector2f lerp(const sf::Vector2f& from, const sf::Vector2f& to, float t) {
+    return from + (to - from) * t;
+}
 
-// Clase Bullet
-class Bullet : public Entity {
-public:
-    Bullet(sf::Vector2f position, sf::Vector2f direction)
-        : shape(3.0f), direction(direction), Entity(position, 0.0f), lifetime(BULLET_LIFE), radius(5.0f) {
-        shape.setFillColor(sf::Color::White);
+// Dibujo por lotes de las entidades, interpolando entre el tick anterior
+// y el último de la foto
+void renderBullets(RenderBatcher& batcher, const RenderSnapshot& snap, float alpha) {
+    for (size_t i = 0; i < snap.bullets.size(); i++) {
+        batcher.addQuad(lerp(snap.previousBullets[i], snap.bullets[i], alpha), 3.0f, sf::Color::White);
     }
+}
 
-    void update(float deltaTime) override {
-        lifetime -= deltaTime;
-        position += direction * BULLET_SPEED * deltaTime;
-
-        if (lifetime <= 0.0f) {
-            toRemoveList.push_back(this);
-        }
+void renderAsteroids(RenderBatcher& batcher, const RenderSnapshot& snap, float alpha) {
+    for (size_t i = 0; i < snap.asteroids.size(); i++) {
+        batcher.addMesh(ASTEROID_MESH, lerp(snap.previousAsteroids[i], snap.asteroids[i], alpha),
+                        lerpAngle(snap.previousAsteroidAngles[i], snap.asteroidAngles[i], alpha));
     }
+}
 
-    void render(sf::RenderWindow& window) override {
-        shape.setPosition(position);
-        window.draw(shape);
+void renderAsteroids(RenderBatcher& batcher, const AsteroidArrays& asteroids) {
+    for (size_t i = 0; i < asteroids.size(); i++) {
+        batcher.addMesh(ASTEROID_MESH, asteroids.position(i), asteroids.angle[i]);
     }
+}
 
-private:
-    sf::CircleShape shape;
-    sf::Vector2f direction;
-    float lifetime;
-    float radius;
-};
+// Borde de un mundo de worldSize, en coordenadas del mundo
+LineMesh worldBorderMesh(const sf::Vector2f& worldSize) {
+    const sf::Vector2f corners[] = {
+        { 0.0f, 0.0f }, { worldSize.x, 0.0f }, { worldSize.x, worldSize.y }, { 0.0f, worldSize.y }, { 0.0f, 0.0f }
+    };
+    return LineMesh(corners, 5, sf::Color(90, 90, 90));
+}
 
-// Clase Player
-class Player : public Entity {
-public:
-    Player()
-        : Entity(sf::Vector2f(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2), 0), array(sf::LinesStrip, 5), shootTimer(0) {
-        array[0].position = sf::Vector2f(20, 0);
-        array[1].position = sf::Vector2f(-30, -20);
-        array[2].position = sf::Vector2f(-15, 0);
-        array[3].position = sf::Vector2f(-30, 20);
-        array[4].position = array[0].position;
-
-        for (size_t i = 0; i < array.getVertexCount(); i++) {
-            array[i].color = sf::Color::White;
-        }
-        shootSoundBuffer.loadFromFile("assets/music/Shoot.wav");
-        ShootSound.setBuffer(shootSoundBuffer);
-        ShootSound.setVolume(100); // Volumen máximo
+void renderPlayer(RenderBatcher& batcher, const RenderSnapshot& snap, float alpha) {
+    batcher.addMesh(PLAYER_MESH, lerp(snap.previousPlayer.position, snap.player.position, alpha),
+                    lerpAngle(snap.previousPlayer.angle, snap.player.angle, alpha));
+}
 
+// Chispas de los asteroides destruidos desde la baja 'fromKill' y estela de
+// la nave si el último tick aceleraba. 'thrustCarry' guarda la fracción de
+// partícula que sobra de un frame para el siguiente.
+void emitParticles(ParticleSystem& particles, const RenderSnapshot& snap, std::uint64_t fromKill,
+                   float alpha, float dt, float& thrustCarry) {
+    std::uint64_t first = std::max(fromKill, snap.kills > RENDER_EXPLOSION_HISTORY ? snap.kills - RENDER_EXPLOSION_HISTORY : 0);
+    for (std::uint64_t k = first; k < snap.kills; k++) {
+        particles.burst(snap.explosions[k % RENDER_EXPLOSION_HISTORY], EXPLOSION_PARTICLES, EXPLOSION_SPEED,
+                        EXPLOSION_LIFE, EXPLOSION_COLOR);
     }
 
-    void update(float deltaTime) override {
-        shootTimer -= deltaTime;
+    if (!(snap.input & INPUT_THRUST)) {
+        thrustCarry = 0.0f;
+        return;
+    }
+    thrustCarry += THRUST_PARTICLE_RATE * dt;
+    std::uint32_t count = static_cast<std::uint32_t>(thrustCarry);
+    thrustCarry -= static_cast<float>(count);
+    BinaryAngle angle = lerpAngle(snap.previousPlayer.angle, snap.player.angle, alpha);
+    sf::Vector2f nozzle = lerp(snap.previousPlayer.position, snap.player.position, alpha)
+                        - angleDirection(angle) * THRUST_OFFSET;
+    particles.jet(nozzle, angle + ANGLE_HALF_TURN, THRUST_SPREAD, count, THRUST_SPEED, THRUST_LIFE, THRUST_COLOR);
+}
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-            angle -= TURN_SPEED * deltaTime;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-            angle += TURN_SPEED * deltaTime;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-            float radians = angle * (M_P / 180.0f);
-            position.x += cos(radians) * PLAYER_SPEED * deltaTime;
-            position.y += sin(radians) * PLAYER_SPEED * deltaTime;
+// Fases que mide el hilo de simulación (el resto, el de render)
+bool isSimulationPhase(ProfilePhase phase) {
+    return phase >= ProfilePhase::Spawn && phase <= ProfilePhase::Apply;
+}
 
-            position.x = std::min(std::max(position.x, PLAYER_W / 2.0f), SCREEN_WIDTH - PLAYER_W / 2.0f);
-            position.y = std::min(std::max(position.y, PLAYER_H / 2.0f), SCREEN_HEIGHT - PLAYER_H / 2.0f);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && shootTimer <= 0.0f) {
-            ShootSound.play();
-            shootTimer = SHOOT_DELAY;
-            float radians = angle * (M_P / 180.0f);
-            toAddList.push_back(new Bullet(position, sf::Vector2f(cos(radians), sin(radians))));
-        }
+// Texto del overlay: p50/p99 de cada fase, del tick y del frame, en
+// milisegundos. Las fases de la simulación llegan ya calculadas en la foto.
+std::string profileReport(Profiler& profiler, const RenderSnapshot& snap, FramePacer& pacer,
+                          const ParticleSystem& particles) {
+    char line[96];
+    std::string report;
+    std::snprintf(line, sizeof(line), "%-12s %7s %7s\n", "ms", "p50", "p99");
+    report += line;
+    for (std::size_t p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+        ProfilePhase phase = static_cast<ProfilePhase>(p);
+        bool simPhase = isSimulationPhase(phase);
+        std::snprintf(line, sizeof(line), "%-12s %7.2f %7.2f\n", profilePhaseName(phase),
+                      simPhase ? snap.phaseP50[p] : profiler.phasePercentile(phase, 0.5),
+                      simPhase ? snap.phaseP99[p] : profiler.phasePercentile(phase, 0.99));
+        report += line;
     }
-
-    void render(sf::RenderWindow& window) override {
-        window.draw(array, sf::Transform().translate(position).rotate(angle));
+    std::snprintf(line, sizeof(line), "%-12s %7.2f %7.2f\n", "tick", snap.tickP50, snap.tickP99);
+    report += line;
+    std::snprintf(line, sizeof(line), "%-12s %7.2f %7.2f\n", "frame",
+                  profiler.framePercentile(0.5), profiler.framePercentile(0.99));
+    report += line;
+    std::snprintf(line, sizeof(line), "%-12s %7.2f %7.2f\n", "retraso",
+                  pacer.jitterPercentile(0.5), pacer.jitterPercentile(0.99));
+    report += line;
+    std::snprintf(line, sizeof(line), "plazos perdidos %llu de %llu\n",
+                  static_cast<unsigned long long>(pacer.stats.missed),
+                  static_cast<unsigned long long>(pacer.stats.frames));
+    report += line;
+    std::snprintf(line, sizeof(line), "particulas %zu\n", particles.size());
+    report += line;
+    if (profiler.size() > 0) {
+        const FrameRecord& last = profiler.frame(profiler.size() - 1);
+        std::snprintf(line, sizeof(line), "balas %u  asteroides %u\npares %llu  reservas %llu",
+                      last.counters.bullets, last.counters.asteroids,
+                      static_cast<unsigned long long>(last.counters.pairsTested),
+                      static_cast<unsigned long long>(last.allocations));
+        report += line;
     }
+    return report;
+}
 
-private:
-    sf::VertexArray array;
-    float shootTimer;
-    sf::SoundBuffer shootSoundBuffer;
-    sf::Sound ShootSound;
+// Opciones de la línea de comandos
+struct GameOptions {
+    bool chipmunk = false;
+    std::string recordPath;   // Grabar la sesión en este archivo al salir
+    std::string replayPath;   // Reproducir esta grabación en vez de jugar
+    bool unthrottled = false; // La repetición a la máxima velocidad
+    float tickRate = 1.0f / SIM_DT; // Ticks por segundo de la simulación
+    float fps = 60.0f;              // Frames por segundo del render (0: sin límite)
+    float worldWidth = SCREEN_WIDTH;   // Tamaño del mundo (la cámara sigue a la nave)
+    float worldHeight = SCREEN_HEIGHT;
+    std::uint32_t asteroids = 0;       // Asteroides al empezar cada partida
 };
 
-// Clase Asteroid
-class Asteroid : public Entity {
-public:
-    Asteroid(sf::Vector2f direction = Asteroid::getRandomDirection(),
-             sf::Vector2f position = Asteroid::getRandomPosition())
-        : Entity(position, 0), direction(direction), array(sf::LinesStrip, 12) {
-        array[0].position = sf::Vector2f(-40, 40);
-        array[1].position = sf::Vector2f(-50, 10);
-        array[2].position = sf::Vector2f(-10, -20);
-        array[3].position = sf::Vector2f(-20, -40);
-        array[4].position = sf::Vector2f(10, -40);
-        array[5].position = sf::Vector2f(40, -20);
-        array[6].position = sf::Vector2f(40, -10);
-        array[7].position = sf::Vector2f(10, 0);
-        array[8].position = sf::Vector2f(40, 20);
-        array[9].position = sf::Vector2f(20, 40);
-        array[10].position = sf::Vector2f(0, 30);
-        array[11].position = array[0].position;
-
-        for (size_t i = 0; i < array.getVertexCount(); i++) {
-            array[i].color = sf::Color::White;
-        }
+// Partida completa con el mundo indicado (Simulation o PhysicsSimulation)
+template <typename World>
+int runGame(const GameOptions& options) {
+    // Semilla y configuración: las de la grabación al repetirla
+    const RecordingBackend backend = std::is_same<World, PhysicsSimulation>::value ? RecordingBackend::Chipmunk
+                                                                                    : RecordingBackend::Simulation;
+    InputRecording recording;
+    recording.seed = static_cast<std::uint32_t>(time(0));
+    recording.backend = backend;
+    recording.dt = 1.0f / options.tickRate;
+    recording.config.worldWidth = options.worldWidth;
+    recording.config.worldHeight = options.worldHeight;
+    recording.config.initialAsteroids = options.asteroids;
+    if (options.worldWidth > SCREEN_WIDTH || options.worldHeight > SCREEN_HEIGHT) {
+        recording.config.farTickInterval = FAR_TICK_INTERVAL;
     }
-
-    void update(float deltaTime) override {
-        position += ASTEROID_SPEED * direction * deltaTime;
-        angle += ASTEROID_SPIN * deltaTime;
-
-        if (position.x <= ASTEROID_W / 2.0f || position.x >= SCREEN_WIDTH - ASTEROID_W / 2.0f) {
-            direction.x = -direction.x;
+    const bool replaying = !options.replayPath.empty();
+    if (replaying) {
+        if (!recording.load(options.replayPath)) {
+            std::cerr << "Error al leer la grabación " << options.replayPath << std::endl;
+            return -1;
         }
-        if (position.y <= ASTEROID_H / 2.0f || position.y >= SCREEN_HEIGHT - ASTEROID_H / 2.0f) {
-            direction.y = -direction.y;
+        if (recording.backend != backend) {
+            std::cerr << "La grabación es de otro motor de física" << std::endl;
+            return -1;
         }
     }
 
-    void render(sf::RenderWindow& window) override {
-        window.draw(array, sf::Transform().translate(position).rotate(angle));
-    }
-
-    static sf::Vector2f getRandomDirection() {
-        static std::mt19937 gen(static_cast<unsigned int>(time(0)));
-        std::uniform_real_distribution<float> dist(0.0f, 2.0f * M_P);
-        float angle = dist(gen);
-        return sf::Vector2f(cos(angle), sin(angle));
-    }
-
-    static sf::Vector2f getRandomPosition() {
-        static std::mt19937 gen(static_cast<unsigned int>(time(0)));
-        std::uniform_real_distribution<float> xAxis(ASTEROID_W / 2.0f, SCREEN_WIDTH - ASTEROID_W / 2.0f);
-        std::uniform_real_distribution<float> yAxis(ASTEROID_W / 2.0f, SCREEN_HEIGHT - ASTEROID_H / 2.0f);
-        return sf::Vector2f(xAxis(gen), yAxis(gen));
-    }
-
-private:
-    float radius = ASTEROID_W / 2.0f;
-    sf::VertexArray array;
-    sf::Vector2f direction;
-};
-
-std::vector<Asteroid*> inicioAsteroids;
-
-// Función principal
-int main() {
     sf::RenderWindow window(sf::VideoMode(static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT)), "Asteroids Game", sf::Style::Close | sf::Style::Titlebar);
-    sf::Clock clock;
 
-    // Música de fondo
-    sf::Music backgroundMusic;
-    if (!backgroundMusic.openFromFile("assets/music/message-of-the-sun-72756.mp3")) {
-        std::cerr << "Error al cargar el archivo de música de fondo." << std::endl;
-        return -1;
-    }
-    backgroundMusic.setLoop(true);
-    backgroundMusic.setVolume(70);
-    backgroundMusic.play();
-
-    // Entidades del juego
-    std::vector<Entity*> entities;
-    entities.push_back(new Player());
-
-    int score = 0; // Puntaje inicial
-
-    // Cargar la fuente
-    sf::Font font;
-    if (!font.loadFromFile("assets/fonts/Minecraft.ttf")) {
-        std::cerr << "Cannot load the font." << std::endl;
-        return -1;
+    // Cargar todos los recursos en paralelo; mientras tanto ya se pinta la
+    // pantalla de inicio (sin textos hasta que llegue la fuente)
+    sf::Clock loadClock;
+    AssetCache assets;
+    auto archive = std::make_shared<AssetArchive>();
+    if (archive->open(ARCHIVE_PATH)) {
+        assets.mount(archive);
     }
+    assets.preloadFont(FONT_PATH);
+    assets.preloadSound(SHOOT_SOUND_PATH);
+    assets.preloadSound(EXPLOSION_SOUND_PATH);
+    assets.preloadFile(MUSIC_PATH);
+    bool assetsReady = false;
+
+    AssetHandle<sf::Font> font;
+    AssetHandle<FileData> musicData;
+    AssetHandle<sf::SoundBuffer> shootSoundBuffer;
+    AssetHandle<sf::SoundBuffer> explosionBuffer;
+    sf::Music backgroundMusic;
 
-    // Crear el texto para el puntaje
-    sf::Text scoreText;
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(40); // Tamaño de la fuente
-    scoreText.setFillColor(sf::Color::White); // Color blanco
-    scoreText.setPosition(50.0f, 50.0f); // Posición del puntaje
-
-    float asteroidSpawnTime = ASTEROID_SPAWN_TIME;
-    sf::SoundBuffer explosionBuffer;
-    sf::Sound explosionSound;
-    if (!explosionBuffer.loadFromFile("assets/music/pop.mp3")) {
-        std::cerr << "Error al cargar el archivo de sonido de explosión." << std::endl;
-        return -1;
+    // Efectos de sonido: las explosiones tienen prioridad sobre los disparos
+    SoundMixer mixer;
+    SoundId shootSfx = 0;
+    SoundId explosionSfx = 0;
+
+    // Simulación de la partida en su propio hilo, a paso fijo, repartida
+    // entre todos los núcleos. El render solo ve las fotos que publica.
+    JobSystem jobs;
+    SimulationThread<World> simThread(recording.seed, recording.config, &jobs, recording.dt);
+    simThread.setProfilePaths(SIM_PROFILE_CSV_PATH, SIM_PROFILE_TRACE_PATH);
+    if (replaying) {
+        simThread.replayFrom(recording, options.unthrottled);
+    } else if (!options.recordPath.empty()) {
+        simThread.recordTo(recording);
     }
-    explosionSound.setBuffer(explosionBuffer);
-    explosionSound.setVolume(100);
-
-    bool gameOver = false;  // Variable que indica si el juego ha terminado
-    bool gameStarted = false; // Variable que indica si el juego ha iniciado
+    simThread.start();
+    std::uint64_t heardShots = 0;
+    std::uint64_t heardKills = 0;
+
+    // Tiempos por fase de los últimos frames del render (F3 muestra, F4
+    // exporta); la simulación lleva su propio profiler
+    Profiler profiler;
+    UILayer profilerOverlay;
+    Label* profilerText = nullptr;
+    bool showProfiler = false;
+    int overlayCountdown = 0;
+
+    // Lotes de vértices: una draw call para las partículas, otra para las
+    // líneas y otra para las balas
+    RenderBatcher batcher;
+
+    // Cámara de la partida: sigue a la nave sin salirse del mundo. El borde
+    // solo se dibuja si el mundo es más grande que la ventana.
+    const sf::Vector2f worldSize(recording.config.worldWidth, recording.config.worldHeight);
+    const bool scrolling = worldSize.x > SCREEN_WIDTH || worldSize.y > SCREEN_HEIGHT;
+    const LineMesh worldBorder = worldBorderMesh(worldSize);
+    sf::View camera(sf::FloatRect(0.0f, 0.0f, SCREEN_WIDTH, SCREEN_HEIGHT));
+
+    // Partículas de efectos, con el dt de cada frame del render
+    ParticleSystem particles(PARTICLE_CAPACITY, static_cast<std::uint32_t>(time(0)));
+    float thrustCarry = 0.0f;
+    sf::Clock frameClock;
+
+    // Ritmo del render: options.fps durante la partida y pocos frames por
+    // segundo en las pantallas quietas
+    FramePacer pacer(options.fps);
+
+    // Interfaz: cada pantalla se construye una vez (al llegar la fuente)
+    // y se redibuja solo si cambia
+    UILayer titleScreen;
+    UILayer gameOverScreen;
+    UILayer hud;
+    Label* scoreText = nullptr;
+    int shownScore = 0;
 
     // Asteroides en la pantalla de inicio
+    std::mt19937 titleGen(static_cast<unsigned int>(time(0)));
+    AsteroidArrays inicioAsteroids;
+    inicioAsteroids.reserve(10);
     for (int i = 0; i < 10; i++) {
-        inicioAsteroids.push_back(new Asteroid());
-        inicioAsteroids[i]->position = sf::Vector2f(fmod(rand(), SCREEN_WIDTH), fmod(rand(), SCREEN_HEIGHT));
+        inicioAsteroids.push(sf::Vector2f(fmod(rand(), SCREEN_WIDTH), fmod(rand(), SCREEN_HEIGHT)), randomAsteroidDirection(titleGen));
     }
 
     while (window.isOpen()) {
-        float deltaTime = clock.restart().asSeconds();
-        sf::Event e{};
-        while (window.pollEvent(e)) {
-            if (e.type == sf::Event::Closed) {
-                window.close();
+        // Terminar la puesta en marcha cuando todos los recursos estén cargados
+        if (!assetsReady && assets.allReady()) {
+            font = assets.font(FONT_PATH);
+            musicData = assets.file(MUSIC_PATH);
+            shootSoundBuffer = assets.sound(SHOOT_SOUND_PATH);
+            explosionBuffer = assets.sound(EXPLOSION_SOUND_PATH);
+            if (!font) {
+                std::cerr << "Cannot load the font: " << FONT_PATH << std::endl;
+            }
+            if (!musicData) {
+                std::cerr << "Error al cargar el archivo de música de fondo: " << MUSIC_PATH << std::endl;
+            }
+            if (!shootSoundBuffer) {
+                std::cerr << "Error al cargar el archivo de sonido de disparo: " << SHOOT_SOUND_PATH << std::endl;
+            }
+            if (!explosionBuffer) {
+                std::cerr << "Error al cargar el archivo de sonido de explosión: " << EXPLOSION_SOUND_PATH << std::endl;
+            }
+            if (!font || !musicData || !shootSoundBuffer || !explosionBuffer) {
+                return -1;
             }
 
-            // Detectar si el jugador presiona Enter para iniciar el juego
-            if (!gameStarted && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Return) {
-                gameStarted = true;
+            const sf::Vector2f center(0.5f, 0.5f);
+            titleScreen.addLabel(*font, 80, { center, { 0, 0 }, { 0.5f, 0.5f } }, "DART PROYECT");
+            titleScreen.addLabel(*font, 40, { center, { 0, 100 }, { 0.5f, 0 } }, "Press Enter to Start");
+            gameOverScreen.addLabel(*font, 80, { center, { 0, 0 }, { 0.5f, 0.5f } }, "GAME OVER");
+            gameOverScreen.addLabel(*font, 40, { center, { 0, 100 }, { 0.5f, 0 } }, "Press P to Restart");
+            gameOverScreen.addLabel(*font, 40, { center, { 0, 150 }, { 0.5f, 0 } }, "Press E to Exit");
+            scoreText = &hud.addLabel(*font, 40, { { 0, 0 }, { 50.0f, 50.0f }, { 0, 0 } }, "Score: 0");
+            profilerText = &profilerOverlay.addLabel(*font, 16, { { 1, 0 }, { -20.0f, 20.0f }, { 1, 0 } });
+
+            shootSfx = mixer.addSound(shootSoundBuffer, { 1, 2, 100.0f });
+            explosionSfx = mixer.addSound(explosionBuffer, { 2, 6, 100.0f });
+
+            // Música de fondo, en streaming desde la copia en memoria
+            if (!backgroundMusic.openFromMemory(musicData->data(), musicData->size())) {
+                std::cerr << "Error al cargar el archivo de música de fondo." << std::endl;
+                return -1;
             }
+            backgroundMusic.setLoop(true);
+            backgroundMusic.setVolume(70);
+            backgroundMusic.play();
 
-            // Detectar si el jugador presiona Space para reiniciar el juego
-            if (gameOver && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
-                // Reiniciar el juego
-                gameOver = false;
-                score = 0;
+            assetsReady = true;
+            std::cout << "Recursos cargados en " << loadClock.getElapsedTime().asMilliseconds() << " ms"
+                      << (archive->isOpen() ? " (" + ARCHIVE_PATH + ")" : "") << std::endl;
+        }
 
-                // Limpiar las entidades y reiniciar
-                for (auto& entity : entities) {
-                    delete entity;
-                }
-                entities.clear();
-                entities.push_back(new Player());  // Crear el jugador nuevamente
-            }
+        profiler.beginFrame();
+        const float frameDt = std::min(frameClock.restart().asSeconds(), 0.1f);
 
-            // Detectar si el jugador presiona E para salir en el Game Over
-            if (gameOver && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::E) {
-                window.close();
-            }
+        // Última foto de la simulación (sin esperar: si no hay una nueva se
+        // sigue interpolando con la que ya teníamos)
+        simThread.acquireSnapshot();
+        const RenderSnapshot& snap = simThread.snapshot();
+        std::uint64_t pairsTestedBefore = snap.pairsTested;
+
+        // La repetición termina con su último frame
+        if (snap.replayFinished) {
+            window.close();
         }
 
-        // Lógica de generación de asteroides
-        if (gameStarted) {
-            asteroidSpawnTime -= deltaTime;
-            if (asteroidSpawnTime <= 0.0f) {
-                asteroidSpawnTime = ASTEROID_SPAWN_TIME;
-                toAddList.push_back(new Asteroid());
-            }
+        {
+            ProfileScope scope(&profiler, ProfilePhase::Events);
+            sf::Event e{};
+            while (window.pollEvent(e)) {
+                if (e.type == sf::Event::Closed) {
+                    window.close();
+                }
 
-            // Actualización de las entidades
-            for (auto& entity : entities) {
-                entity->update(deltaTime);
-            }
-            // Detectar colisiones entre balas y asteroides
-            for (auto& entity1 : entities) {
-                Bullet* bullet = dynamic_cast<Bullet*>(entity1);
-                if (bullet) {
-                    for (auto& entity2 : entities) {
-                        Asteroid* asteroid = dynamic_cast<Asteroid*>(entity2);
-                        if (asteroid && checkCollision(bullet->position, 5.0f, asteroid->position, ASTEROID_W / 2.0f)) {
-                            // Colisión detectada
-                            toRemoveList.push_back(bullet);
-                            toRemoveList.push_back(asteroid);
-                            score += 20; // Incrementar puntaje al destruir un asteroide
-                        }
-                    }
+                // Detectar si el jugador presiona Enter para iniciar el juego
+                if (assetsReady && !snap.started && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Return) {
+                    simThread.requestStart();
+                }
+
+                // Detectar si el jugador presiona P para reiniciar el juego
+                if (snap.gameOver && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
+                    simThread.requestRestart();
+                }
+
+                // Detectar si el jugador presiona E para salir en el Game Over
+                if (snap.gameOver && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::E) {
+                    window.close();
                 }
-            }
 
-            // Detectar colisión entre el jugador y los asteroides
-            for (auto& entity : entities) {
-                Player* player = dynamic_cast<Player*>(entity);
-                if (player) {
-                    for (auto& entity2 : entities) {
-                        Asteroid* asteroid = dynamic_cast<Asteroid*>(entity2);
-                        if (asteroid && checkCollision(player->position, PLAYER_W / 2.0f, asteroid->position, ASTEROID_W / 2.0f)) {
-                            // Colisión detectada entre el jugador y un asteroide
-                            gameOver = true;  // El juego ha terminado
-                        }
+                // F3: mostrar u ocultar el profiler; F4: exportar lo medido
+                if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::F3) {
+                    showProfiler = !showProfiler;
+                    overlayCountdown = 0;
+                }
+                if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::F4) {
+                    simThread.requestProfileExport();
+                    if (profiler.exportCsv(PROFILE_CSV_PATH) && profiler.exportTrace(PROFILE_TRACE_PATH)) {
+                        std::cout << "Profiler del render exportado a " << PROFILE_CSV_PATH << " y "
+                                  << PROFILE_TRACE_PATH << std::endl;
+                    } else {
+                        std::cerr << "Error al exportar el profiler del render" << std::endl;
                     }
                 }
             }
+        }
 
-            // Eliminar entidades marcadas para ser eliminadas
-            for (auto& entity : toRemoveList) {
-                auto it = std::find(entities.begin(), entities.end(), entity);
-                if (it != entities.end()) {
-                    delete *it;
-                    entities.erase(it);
+        // La simulación toma la entrada en su próximo tick
+        simThread.setInput(snap.started ? sampleKeyboard() : 0);
+
+        if (snap.started && !snap.gameOver) {
+            ProfileScope scope(&profiler, ProfilePhase::Particles);
+            emitParticles(particles, snap, heardKills, snap.alpha(std::chrono::steady_clock::now()), frameDt, thrustCarry);
+            particles.update(frameDt);
+        } else {
+            particles.clear();
+        }
+
+        if (snap.started) {
+            // Sonidos de lo ocurrido desde la última foto vista
+            {
+                ProfileScope scope(&profiler, ProfilePhase::Audio);
+                if (snap.shots > heardShots) {
+                    mixer.play(shootSfx);
+                }
+                for (std::uint64_t k = heardKills; k < snap.kills; k++) {
+                    mixer.play(explosionSfx);
                 }
+                heardShots = snap.shots;
+                heardKills = snap.kills;
+                mixer.update();
             }
-            toRemoveList.clear();
 
-            // Añadir nuevas entidades
-            for (auto& entity : toAddList) {
-                entities.push_back(entity);
+            // Actualizar el texto del puntaje si ha cambiado
+            if (snap.score != shownScore) {
+                shownScore = snap.score;
+                scoreText->setString("Score: " + std::to_string(shownScore));
             }
-            toAddList.clear();
-
-            // Actualizar el texto del puntaje
-            scoreText.setString("Score: " + std::to_string(score));
         }
 
         // Renderizado
-        if (gameOver) {
-            // Limpiar la pantalla con fondo negro cuando el juego haya terminado
-            window.clear(sf::Color::Black);
-
-            // Mostrar el mensaje de "Game Over"
-            sf::Text gameOverText;
-            gameOverText.setFont(font);
-            gameOverText.setCharacterSize(80);
-            gameOverText.setFillColor(sf::Color::White);
-            gameOverText.setString("GAME OVER");
-            gameOverText.setPosition(SCREEN_WIDTH / 2 - gameOverText.getLocalBounds().width / 2, 
-                                     SCREEN_HEIGHT / 2 - gameOverText.getLocalBounds().height / 2);
-            window.draw(gameOverText);
-
-            // Mostrar la opción de reiniciar
-            sf::Text restartText;
-            restartText.setFont(font);
-            restartText.setCharacterSize(40);
-            restartText.setFillColor(sf::Color::White);
-            restartText.setString("Press P to Restart");
-            restartText.setPosition(SCREEN_WIDTH / 2 - restartText.getLocalBounds().width / 2, 
-                                    SCREEN_HEIGHT / 2 + 100);
-            window.draw(restartText);
-
-            // Mostrar la opción de salir
-            sf::Text exitText;
-            exitText.setFont(font);
-            exitText.setCharacterSize(40);
-            exitText.setFillColor(sf::Color::White);
-            exitText.setString("Press E to Exit");
-            exitText.setPosition(SCREEN_WIDTH / 2 - exitText.getLocalBounds().width / 2, 
-                                SCREEN_HEIGHT / 2 + 150);
-            window.draw(exitText);
-        } else if (!gameStarted) {
-            // Limpiar la pantalla con fondo negro cuando el juego no ha iniciado
-            window.clear(sf::Color::Black);
-
-            // Mostrar el título del juego
-            sf::Text titleText;
-            titleText.setFont(font);
-            titleText.setCharacterSize(80);
-            titleText.setFillColor(sf::Color::White);
-            titleText.setString("DART PROYECT");
-            titleText.setPosition(SCREEN_WIDTH / 2 - titleText.getLocalBounds().width / 2, 
-                                  SCREEN_HEIGHT / 2 - titleText.getLocalBounds().height / 2);
-            window.draw(titleText);
-
-            // Mostrar la opción de iniciar el juego
-            sf::Text startText;
-            startText.setFont(font);
-            startText.setCharacterSize(40);
-            startText.setFillColor(sf::Color::White);
-            startText.setString("Press Enter to Start");
-            startText.setPosition(SCREEN_WIDTH / 2 - startText.getLocalBounds().width / 2, 
-                                  SCREEN_HEIGHT / 2 + 100);
-            window.draw(startText);
-
-            // Mostrar los asteroides en la pantalla de inicio
-            for (auto& asteroid : inicioAsteroids) {
-                asteroid->render(window);
+        {
+            ProfileScope scope(&profiler, ProfilePhase::Render);
+            if (snap.gameOver) {
+                // Limpiar la pantalla con fondo negro cuando el juego haya terminado
+                window.clear(sf::Color::Black);
+
+                // Mostrar "Game Over" y las opciones de reiniciar y salir
+                gameOverScreen.draw(window);
+            } else if (!snap.started) {
+                // Limpiar la pantalla con fondo negro cuando el juego no ha iniciado
+                window.clear(sf::Color::Black);
+
+                // Mostrar el título del juego y la opción de iniciar
+                titleScreen.draw(window);
+
+                // Mostrar los asteroides en la pantalla de inicio
+                batcher.begin();
+                renderAsteroids(batcher, inicioAsteroids);
+                batcher.flush(window);
+            } else {
+                // Limpiar la pantalla y mostrar el juego normal si no está en "Game Over"
+                float alpha = snap.alpha(std::chrono::steady_clock::now());
+                camera.setCenter(cameraCenter(lerp(snap.previousPlayer.position, snap.player.position, alpha),
+                                              snap.worldSize));
+                window.clear();
+                window.setView(camera);
+                batcher.begin();
+                batcher.addParticles(particles);
+                if (scrolling) {
+                    batcher.addMesh(worldBorder, { 0.0f, 0.0f }, 0);
+                }
+                renderAsteroids(batcher, snap, alpha);
+                renderBullets(batcher, snap, alpha);
+                renderPlayer(batcher, snap, alpha);
+                batcher.flush(window);
+                window.setView(window.getDefaultView());
+                hud.draw(window); // Dibujar el puntaje
             }
-        } else {
-            // Limpiar la pantalla y mostrar el juego normal si no está en "Game Over"
-            window.clear();
-            for (auto& entity : entities) {
-                entity->render(window);
+
+            // Overlay del profiler (el texto se rehace cada pocos frames)
+            if (showProfiler && profilerText) {
+                if (--overlayCountdown <= 0) {
+                    overlayCountdown = PROFILE_OVERLAY_INTERVAL;
+                    profilerText->setString(profileReport(profiler, snap, pacer, particles));
+                }
+                profilerOverlay.draw(window);
             }
-            window.draw(scoreText); // Dibujar el puntaje
         }
 
-        window.display();
+        {
+            ProfileScope scope(&profiler, ProfilePhase::Present);
+            window.display();
+        }
+        profiler.endFrame({ static_cast<std::uint32_t>(snap.bullets.size()), static_cast<std::uint32_t>(snap.asteroids.size()),
+                            snap.pairsTested - pairsTestedBefore });
+
+        // Solo la partida anima; la carga, el título y el game over no
+        pacer.setActive(assetsReady && snap.started && !snap.gameOver);
+        pacer.wait();
+    }
+    simThread.stop();
+
+    if (const InputReplay* replay = simThread.replayResult()) {
+        std::cout << "Repetición: " << replay->framesPlayed() << " de " << recording.frameCount() << " frames, "
+                  << replay->checkpointsMatched() << " checkpoints correctos, "
+                  << replay->checkpointsMismatched() << " distintos";
+        if (replay->checkpointsMismatched() > 0) {
+            std::cout << " (el primero en el frame " << replay->firstMismatchFrame() << ")";
+        }
+        std::cout << std::endl;
+    } else if (!options.recordPath.empty()) {
+        if (recording.save(options.recordPath)) {
+            std::cout << "Sesión grabada en " << options.recordPath << " (" << recording.frameCount() << " frames, "
+                      << recording.runs.size() << " tramos)" << std::endl;
+        } else {
+            std::cerr << "Error al guardar la grabación " << options.recordPath << std::endl;
+        }
     }
 
-    // Liberar memoria
-    for (auto& entity : entities) {
-        delete entity;
+    // Resumen del ritmo de frames
+    const FramePacerStats& pacing = pacer.stats;
+    if (pacing.frames > 0) {
+        std::cout << "Frames: " << pacing.frames << " a " << pacer.targetFps() << " fps ("
+                  << pacing.idleFrames << " en pantallas quietas), " << pacing.missed << " plazos perdidos, retraso p50 "
+                  << pacer.jitterPercentile(0.5) << " ms, p99 " << pacer.jitterPercentile(0.99) << " ms; "
+                  << pacing.sleptSeconds << " s dormido y " << pacing.spunSeconds << " s girando" << std::endl;
     }
 
-    for (auto& asteroid : inicioAsteroids) {
-        delete asteroid;
+    // Resumen del broadphase
+    const World& sim = simThread.simulation();
+    std::uint64_t totalTicks = simThread.ticksRun();
+    if (totalTicks > 0) {
+        std::cout << "Broadphase: " << sim.stats.pairsTested << " pares probados, "
+                  << sim.stats.pairsHit << " impactos en " << totalTicks << " ticks ("
+                  << sim.stats.pairsTested / totalTicks << " pares/tick)" << std::endl;
     }
 
     return 0;
 }
 
-
-
-
-
+// Función principal. Con "--physics chipmunk" el movimiento y las colisiones
+// los hace Chipmunk en lugar del código propio. "--tick-rate" cambia los
+// ticks por segundo de la simulación (con la colisión continua basta con 30;
+// el render interpola igual) y "--fps" los frames por segundo del render.
+// "--record" guarda la sesión al salir y "--replay" la vuelve a reproducir
+// (con "--unthrottled", sin esperar al reloj). "--world" da un mundo más
+// grande que la ventana, con la cámara siguiendo a la nave, y "--asteroids"
+// los asteroides con que empieza.
+int main(int argc, char* argv[]) {
+    GameOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--physics" && hasValue && std::string(argv[i + 1]) == "chipmunk") {
+            options.chipmunk = true;
+            i++;
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--tick-rate" && hasValue) {
+            options.tickRate = std::min(std::max(1.0f, std::strtof(argv[++i], nullptr)), RECORDING_MAX_TICK_RATE);
+        } else if (arg == "--fps" && hasValue) {
+            options.fps = std::max(0.0f, std::strtof(argv[++i], nullptr));
+        } else if (arg == "--unthrottled") {
+            options.unthrottled = true;
+        } else if (arg == "--world" && i + 2 < argc) {
+            options.worldWidth = std::min(std::max(SCREEN_WIDTH, std::strtof(argv[++i], nullptr)), RECORDING_MAX_WORLD_SIZE);
+            options.worldHeight = std::min(std::max(SCREEN_HEIGHT, std::strtof(argv[++i], nullptr)), RECORDING_MAX_WORLD_SIZE);
+        } else if (arg == "--asteroids" && hasValue) {
+            options.asteroids = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--physics chipmunk] [--tick-rate HZ] [--fps HZ] [--world ANCHO ALTO] [--asteroids K]"
+                      << " [--record archivo | --replay archivo [--unthrottled]]" << std::endl;
+            return -1;
+        }
+    }
+    if (options.chipmunk && (options.worldWidth > SCREEN_WIDTH || options.worldHeight > SCREEN_HEIGHT)) {
+        std::cerr << "Con --physics chipmunk el mundo es del tamaño de la ventana" << std::endl;
+        return -1;
+    }
+    return options.chipmunk ? runGame<PhysicsSimulation>(options) : runGame<Simulation>(options);
+}
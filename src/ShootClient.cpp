@@ -0,0 +1,130 @@
+#include <SFML/Graphics.hpp>
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "GameConfig.hpp"
+#include "NetClient.hpp"
+#include "RenderBatcher.hpp"
+
+// Cliente multijugador con ventana: se conecta a shoot_server, manda el
+// teclado en cada tick y dibuja la nave propia predicha y el resto del
+// mundo interpolado.
+//
+// Uso: ShootClient.exe [servidor] [--port P] [--loss P] [--latency MS] [--jitter MS]
+
+const std::string FONT_PATH = "assets/fonts/Minecraft.ttf";
+
+// Mallas inmutables compartidas por todas las instancias
+const LineMesh ASTEROID_MESH(ASTEROID_HULL, 12);
+const LineMesh PLAYER_MESH(PLAYER_HULL, 5);
+const LineMesh OTHER_PLAYER_MESH(PLAYER_HULL, 5, sf::Color(120, 200, 255));
+
+std::uint8_t sampleKeyboard() {
+    std::uint8_t input = 0;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+        input |= INPUT_LEFT;
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+        input |= INPUT_RIGHT;
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+        input |= INPUT_THRUST;
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+        input |= INPUT_FIRE;
+    }
+    return input;
+}
+
+int main(int argc, char* argv[]) {
+    std::string host = "127.0.0.1";
+    unsigned short port = NET_DEFAULT_PORT;
+    NetConditions conditions;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            port = static_cast<unsigned short>(std::atoi(argv[++i]));
+        } else if (arg == "--loss" && hasValue) {
+            conditions.loss = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--latency" && hasValue) {
+            conditions.latencyMs = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--jitter" && hasValue) {
+            conditions.jitterMs = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg[0] != '-') {
+            host = arg;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [servidor] [--port P] [--loss P] [--latency MS] [--jitter MS]" << std::endl;
+            return -1;
+        }
+    }
+
+    NetClient client(sf::IpAddress(host), port, conditions);
+    if (!client.connect()) {
+        std::cerr << "No se pudo abrir el socket" << std::endl;
+        return 1;
+    }
+
+    sf::RenderWindow window(sf::VideoMode(static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT)),
+                            "Asteroids Online", sf::Style::Close | sf::Style::Titlebar);
+    sf::Font font;
+    bool hasFont = font.loadFromFile(FONT_PATH);
+    sf::Text status;
+    if (hasFont) {
+        status.setFont(font);
+        status.setCharacterSize(32);
+        status.setPosition(50.0f, 50.0f);
+    }
+
+    RenderBatcher batcher;
+    NetView view;
+    sf::Clock clock;
+    float accumulator = 0.0f;
+
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed
+                || (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E)) {
+                window.close();
+            }
+        }
+
+        // Ticks fijos como el servidor; la entrada solo cuenta con la ventana activa
+        accumulator += clock.restart().asSeconds();
+        while (accumulator >= NET_TICK_DT) {
+            accumulator -= NET_TICK_DT;
+            client.update(window.hasFocus() ? sampleKeyboard() : 0);
+        }
+
+        client.view(view);
+        window.clear();
+        batcher.begin();
+        for (size_t i = 0; i < view.asteroids.size(); i++) {
+            batcher.addMesh(ASTEROID_MESH, view.asteroids[i], view.asteroidAngles[i]);
+        }
+        for (const sf::Vector2f& bullet : view.bullets) {
+            batcher.addQuad(bullet, 3.0f, sf::Color::White);
+        }
+        for (const NetView::Ship& ship : view.ships) {
+            batcher.addMesh(ship.own ? PLAYER_MESH : OTHER_PLAYER_MESH, ship.position, ship.angle);
+        }
+        batcher.flush(window);
+        if (hasFont) {
+            if (client.full()) {
+                status.setString("Server full");
+            } else if (!client.connected()) {
+                status.setString("Connecting to " + host + "...");
+            } else {
+                status.setString("Score: " + std::to_string(view.score));
+            }
+            window.draw(status);
+        }
+        window.display();
+    }
+
+    client.disconnect();
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include "GameConfig.hpp"
+#include "InputRecording.hpp"
+#include "Simulation.hpp"
+
+// Simulación sin ventana: ejecuta N ticks a paso fijo tan rápido como puede,
+// con una semilla y una entrada guionizada, e imprime el rendimiento.
+// Con --record guarda la sesión; con --replay reproduce una grabada (del
+// juego o de aquí) sin límite de ritmo y comprueba sus checkpoints.
+//
+// Uso: shoot_headless [--ticks N] [--seed S] [--asteroids K] [--spawn-time T]
+//                      [--invulnerable] [--world W H] [--far-interval K]
+//                      [--threads H] [--tick-rate HZ] [--record F]
+//      shoot_headless --replay F [--threads H]
+
+// Reproduce una grabación tan rápido como se pueda. 0 si todos los
+// checkpoints coinciden.
+int replayRecording(const std::string& path, unsigned threads) {
+    InputRecording recording;
+    if (!recording.load(path)) {
+        std::cerr << "Error al leer la grabación " << path << std::endl;
+        return -1;
+    }
+    if (recording.backend != RecordingBackend::Simulation) {
+        std::cerr << "La grabación es de Chipmunk; repítela con shoot --physics chipmunk --replay" << std::endl;
+        return -1;
+    }
+
+    JobSystem jobs(threads);
+    Simulation sim(recording.seed, recording.config, &jobs);
+    InputReplay replay(recording);
+    bool started = false;
+    std::uint64_t ticks = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (!replay.done()) {
+        if (applySessionFrame(sim, started, replay.next(), recording.dt)) {
+            ticks++;
+        }
+        replay.verify(sim);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Repetición: " << replay.framesPlayed() << " frames en " << recording.runs.size() << " tramos, "
+              << ticks << " ticks (semilla " << recording.seed << ")" << std::endl;
+    std::cout << "Tiempo: " << seconds << " s, " << (seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/s, "
+              << (seconds > 0.0 ? ticks * recording.dt / seconds : 0.0) << "x tiempo real" << std::endl;
+    std::cout << "Checkpoints: " << replay.checkpointsMatched() << " correctos, "
+              << replay.checkpointsMismatched() << " distintos";
+    if (replay.checkpointsMismatched() > 0) {
+        std::cout << " (el primero en el frame " << replay.firstMismatchFrame() << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "Puntaje final: " << sim.score << (sim.gameOver ? " (game over)" : "") << std::endl;
+    return replay.checkpointsMismatched() == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    std::uint64_t ticks = 100000;
+    std::uint32_t seed = 1;
+    SimConfig config;
+    float dt = SIM_DT;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string recordPath;
+    std::string replayPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--ticks" && hasValue) {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--asteroids" && hasValue) {
+            config.initialAsteroids = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--spawn-time" && hasValue) {
+            // Sin negativos ni infinitos, que la grabación no se podría leer
+            config.asteroidSpawnTime = std::min(std::max(0.0f, std::strtof(argv[++i], nullptr)), std::numeric_limits<float>::max());
+        } else if (arg == "--invulnerable") {
+            config.invulnerable = true;
+        } else if (arg == "--world" && i + 2 < argc) {
+            config.worldWidth = std::min(std::max(SCREEN_WIDTH, std::strtof(argv[++i], nullptr)), RECORDING_MAX_WORLD_SIZE);
+            config.worldHeight = std::min(std::max(SCREEN_HEIGHT, std::strtof(argv[++i], nullptr)), RECORDING_MAX_WORLD_SIZE);
+        } else if (arg == "--far-interval" && hasValue) {
+            // Se redondea a potencia de dos hacia abajo
+            std::uint32_t interval = std::max(1u, static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+            config.farTickInterval = 1;
+            while (config.farTickInterval * 2 <= interval && config.farTickInterval < (1u << 30)) {
+                config.farTickInterval *= 2;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--tick-rate" && hasValue) {
+            dt = 1.0f / std::min(std::max(1.0f, std::strtof(argv[++i], nullptr)), RECORDING_MAX_TICK_RATE);
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--ticks N] [--seed S] [--asteroids K] [--spawn-time T] [--invulnerable] [--world W H] [--far-interval K] [--threads H] [--tick-rate HZ] [--record F]" << std::endl;
+            std::cerr << "     " << argv[0] << " --replay F [--threads H]" << std::endl;
+            return -1;
+        }
+    }
+    if (!replayPath.empty()) {
+        return replayRecording(replayPath, threads);
+    }
+
+    JobSystem jobs(threads);
+    Simulation sim(seed, config, &jobs);
+    ScriptedInput input(seed);
+
+    std::uint64_t games = 1;
+    std::uint64_t totalScore = 0;
+    std::uint64_t entitySum = 0;
+    size_t maxBullets = 0;
+    size_t maxAsteroids = 0;
+
+    // Grabación: la partida empieza en el primer frame y cada reinicio va
+    // en el frame siguiente al game over, como en el juego
+    InputRecording recording;
+    recording.seed = seed;
+    recording.config = config;
+    recording.dt = dt;
+    InputRecorder recorder(recording);
+    std::uint8_t control = SESSION_START;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t t = 0; t < ticks; t++) {
+        std::uint8_t bits = input.next(sim.tick);
+        sim.step(bits, dt);
+        if (!recordPath.empty()) {
+            recorder.record(bits | control, sim);
+            control = 0;
+        }
+
+        maxBullets = std::max(maxBullets, sim.bullets.size());
+        maxAsteroids = std::max(maxAsteroids, sim.asteroids.size());
+        entitySum += sim.bullets.size() + sim.asteroids.size();
+
+        // Al perder se empieza otra partida con la misma secuencia aleatoria
+        if (sim.gameOver) {
+            totalScore += sim.score;
+            sim.restart();
+            games++;
+            control = SESSION_RESTART;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    totalScore += sim.score;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Ticks: " << ticks << " (dt = " << dt << " s, semilla " << seed << ", " << jobs.size() << " hilos)" << std::endl;
+    std::cout << "Tiempo: " << seconds << " s, " << (seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/s" << std::endl;
+    std::cout << "Partidas: " << games << ", puntaje total: " << totalScore << std::endl;
+    std::cout << "Entidades: media " << (ticks > 0 ? entitySum / ticks : 0)
+              << ", max balas " << maxBullets << ", max asteroides " << maxAsteroids
+              << ", al final " << sim.bullets.size() << " balas y " << sim.asteroids.size() << " asteroides" << std::endl;
+    std::cout << "Broadphase: " << sim.stats.pairsTested << " pares probados, " << sim.stats.pairsHit << " impactos" << std::endl;
+    if (!recordPath.empty()) {
+        if (!recording.save(recordPath)) {
+            std::cerr << "Error al guardar la grabación " << recordPath << std::endl;
+            return -1;
+        }
+        std::cout << "Grabación: " << recordPath << " (" << recording.frameCount() << " frames, "
+                  << recording.runs.size() << " tramos, " << recording.checkpoints.size() << " checkpoints)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "NetServer.hpp"
+
+// Servidor multijugador sin ventana: simula el mundo a 60 Hz y atiende a
+// los clientes (bin/ShootClient.exe) por UDP. Cada 5 s imprime una línea
+// con los clientes y el tamaño de las fotos.
+//
+// Uso: shoot_server [--port P] [--asteroids K] [--seed S] [--snapshot-rate HZ]
+//                   [--seconds S] [--loss P] [--latency MS] [--jitter MS]
+
+int main(int argc, char* argv[]) {
+    NetServerConfig config;
+    double duration = 0.0;  // 0: sin fin
+    float snapshotRate = 20.0f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            config.port = static_cast<unsigned short>(std::atoi(argv[++i]));
+        } else if (arg == "--asteroids" && hasValue) {
+            config.arena.asteroids = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--snapshot-rate" && hasValue) {
+            snapshotRate = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--seconds" && hasValue) {
+            duration = std::atof(argv[++i]);
+        } else if (arg == "--loss" && hasValue) {
+            config.conditions.loss = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--latency" && hasValue) {
+            config.conditions.latencyMs = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--jitter" && hasValue) {
+            config.conditions.jitterMs = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--port P] [--asteroids K] [--seed S] [--snapshot-rate HZ]"
+                      << " [--seconds S] [--loss P] [--latency MS] [--jitter MS]" << std::endl;
+            return -1;
+        }
+    }
+    if (snapshotRate > 0.0f) {
+        config.snapshotInterval = static_cast<std::uint32_t>(1.0f / (snapshotRate * NET_TICK_DT) + 0.5f);
+    }
+
+    NetServer server(config);
+    if (!server.start()) {
+        std::cerr << "No se pudo abrir el puerto " << config.port << std::endl;
+        return 1;
+    }
+    std::cout << "Servidor en el puerto " << config.port << " (" << config.arena.asteroids << " asteroides, una foto cada "
+              << config.snapshotInterval << " ticks)" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(NET_TICK_DT));
+    const std::uint64_t reportTicks = static_cast<std::uint64_t>(5.0 / NET_TICK_DT);
+    const std::uint64_t ticks = static_cast<std::uint64_t>(duration / NET_TICK_DT);
+    NetServerStats reported;
+    auto next = Clock::now();
+    for (std::uint64_t t = 1; ticks == 0 || t <= ticks; t++) {
+        server.tick();
+        if (t % reportTicks == 0) {
+            const NetServerStats& s = server.stats;
+            std::uint64_t snapshots = s.snapshots - reported.snapshots;
+            std::uint64_t bytes = s.snapshotBytes - reported.snapshotBytes;
+            std::cout << "Tick " << server.arena().tick << ": " << server.clientCount() << " clientes, "
+                      << snapshots << " fotos, media " << (snapshots ? bytes / snapshots : 0) << " bytes, máximo "
+                      << s.maxSnapshotBytes << ", entradas repetidas " << s.missingInputs - reported.missingInputs
+                      << std::endl;
+            reported = s;
+        }
+        next += tickDuration;
+        std::this_thread::sleep_until(next);
+    }
+    return 0;
+}